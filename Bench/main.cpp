@@ -0,0 +1,316 @@
+#include "Core/AI.h"
+#include "Core/Board.h"
+#include "Core/FleetGenerator.h"
+#include "Instrument/AllocCounter.h"
+#ifdef SEABATTLE_BENCH_RENDER
+#include "Render/BoardRenderer.h"
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::vector<ShipSet> PRESETS = {
+    {5,4,3,3,2},
+    {4,3,3,2,2,2},
+    {3,3,2,2,2,1,1}
+};
+
+struct BenchResult {
+    std::string name;
+    int grid;
+    int preset;
+    long long iterations;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+struct BenchOptions {
+    int gridMin = 6, gridMax = 15;
+    int preset = -1;
+    std::string filter;
+    double minSeconds = 0.05;
+    int budgetMs = 5;
+    std::string jsonPath;
+};
+
+// Результат, який оптимізатор не може викинути.
+volatile std::uint32_t sink;
+// Перевірки коректності, зроблені попутно з замірами; false — main поверне 1.
+bool checksPassed = true;
+
+class Runner {
+public:
+    Runner(const BenchOptions& options, std::ostream& log) : options(options), log(log) {}
+
+    bool wants(const std::string& name) const {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    // setup() готує стан поза заміром і повертає, скільки операцій він витримає;
+    // op(i) виконує i-ту операцію і повертає false, коли стан вичерпано.
+    template <class Setup, class Op>
+    void run(const std::string& name, int grid, int preset, Setup setup, Op op, long long maxOps = 0) {
+        if (!wants(name))
+            return;
+        typedef std::chrono::steady_clock Clock;
+        long long iterations = 0, allocs = 0;
+        double seconds = 0;
+        while (seconds < options.minSeconds && (maxOps == 0 || iterations < maxOps)) {
+            long long limit = setup();
+            if (maxOps) limit = std::min(limit, maxOps - iterations);
+            long long before = allocationCount(), n = 0;
+            auto start = Clock::now();
+            while (n < limit) {
+                bool more = op(n);
+                ++n;
+                if (!more) break;
+            }
+            seconds += std::chrono::duration<double>(Clock::now() - start).count();
+            allocs += allocationCount() - before;
+            iterations += n;
+            if (n == 0) break;
+        }
+        if (iterations == 0)
+            return;
+        BenchResult r{ name, grid, preset, iterations, seconds * 1e9 / iterations, double(allocs) / iterations };
+        log << std::left << std::setw(28) << name << std::right
+            << std::setw(4) << grid << std::setw(3) << preset
+            << std::fixed << std::setprecision(1) << std::setw(14) << r.nsPerOp << " ns/op"
+            << std::setprecision(2) << std::setw(10) << r.allocsPerOp << " allocs/op"
+            << std::setw(10) << iterations << std::endl;
+        results.push_back(r);
+    }
+
+    void writeJson(std::ostream& out) const {
+        out << "{\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"grid\": " << r.grid
+                << ", \"preset\": " << r.preset << ", \"fleet\": \"";
+            for (size_t j = 0; j < PRESETS[r.preset].size(); ++j)
+                out << (j ? "," : "") << PRESETS[r.preset][j];
+            out << "\", \"iterations\": " << r.iterations
+                << std::fixed << std::setprecision(2)
+                << ", \"ns_per_op\": " << r.nsPerOp
+                << ", \"allocs_per_op\": " << std::setprecision(4) << r.allocsPerOp << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    const BenchOptions& options;
+    std::ostream& log;
+
+private:
+    std::vector<BenchResult> results;
+};
+
+std::vector<Coord> allCells(int n) {
+    std::vector<Coord> cells;
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+            cells.push_back(Coord(x, y));
+    return cells;
+}
+
+// Розстановка з генератора має бути тим самим флотом, розставленим за правилами Board.
+bool validLayout(const Settings& settings, const FleetLayout& layout) {
+    Board board(true, settings);
+    ShipSet sizes;
+    for (const auto& p : layout.ships) {
+        if (!board.canPlaceShip(p.x, p.y, p.size, p.vertical))
+            return false;
+        board.placeShipManual(p.x, p.y, p.size, p.vertical);
+        sizes.push_back(p.size);
+    }
+    ShipSet expected = settings.shipSet;
+    std::sort(sizes.begin(), sizes.end());
+    std::sort(expected.begin(), expected.end());
+    return sizes == expected && board.shipCells() == layout.cells;
+}
+
+void benchConfig(Runner& runner, int grid, int preset) {
+    Settings settings;
+    settings.gridSize = grid;
+    settings.shipSet = PRESETS[preset];
+    settings.aiTimeBudgetMs = runner.options.budgetMs;
+
+    Rng rng = RngService(12345u + grid * 31 + preset).stream(RngStream::Board);
+    Board layout(false, settings);
+    if (!layout.placeAllShips(rng)) {
+        runner.log << "skip grid " << grid << " preset " << preset << ": fleet does not fit" << std::endl;
+        return;
+    }
+    std::vector<Coord> cells = allCells(grid);
+    long long cellCount = static_cast<long long>(cells.size());
+
+    {
+        // Перший виклик будує кешований генератор флоту; він у замір не входить.
+        Board board(false, settings);
+        board.placeAllShips(rng);
+        runner.run("Board::placeAllShips", grid, preset,
+            [] { return 256LL; },
+            [&](long long) { board.placeAllShips(rng); return true; });
+    }
+    {
+        const size_t bulk = 64;
+        FleetGenerator& generator = FleetGenerator::shared(grid, settings.shipSet);
+        std::vector<FleetLayout> layouts;
+        if (generator.generateBulk(rng, bulk, layouts) != bulk
+            || !std::all_of(layouts.begin(), layouts.end(), [&](const FleetLayout& l) { return validLayout(settings, l); })) {
+            runner.log << "FAIL grid " << grid << " preset " << preset << ": generateBulk returned an invalid fleet" << std::endl;
+            checksPassed = false;
+        }
+        runner.run("FleetGenerator::generateBulk/64", grid, preset,
+            [] { return 64LL; },
+            [&](long long) { sink = sink + static_cast<std::uint32_t>(generator.generateBulk(rng, bulk, layouts)); return true; });
+    }
+    {
+        struct Query { int x, y, size; bool vertical; };
+        std::vector<Query> queries;
+        std::uniform_int_distribution<int> pos(0, grid - 1), coin(0, 1), ship(0, (int)settings.shipSet.size() - 1);
+        for (int i = 0; i < 1024; ++i)
+            queries.push_back(Query{ pos(rng), pos(rng), settings.shipSet[ship(rng)], coin(rng) == 1 });
+        runner.run("Board::canPlaceShip", grid, preset,
+            [] { return 1024LL; },
+            [&](long long i) {
+                const Query& q = queries[i];
+                sink = sink + layout.canPlaceShip(q.x, q.y, q.size, q.vertical);
+                return true;
+            });
+    }
+    {
+        Board board(layout);
+        std::vector<Coord> order = cells;
+        runner.run("Board::receiveShot", grid, preset,
+            [&] { board = layout; std::shuffle(order.begin(), order.end(), rng); return cellCount; },
+            [&](long long i) { sink = sink + board.receiveShot(order[i]); return true; });
+    }
+
+    // Позиція посеред гри: половина клітинок обстріляна, частина кораблів потоплена.
+    Board midgame(layout);
+    {
+        std::vector<Coord> order = cells;
+        std::shuffle(order.begin(), order.end(), rng);
+        for (long long i = 0; i < cellCount / 2; ++i)
+            midgame.receiveShot(order[i]);
+    }
+    runner.run("Board::isSunkCell", grid, preset,
+        [&] { return cellCount; },
+        [&](long long i) { sink = sink + midgame.isSunkCell(cells[i]); return true; });
+    runner.run("Board::allSunk", grid, preset,
+        [] { return 1024LL; },
+        [&](long long) { sink = sink + midgame.allSunk(); return true; });
+
+    // Хід ШІ заміряється разом із застосуванням пострілу до поля:
+    // receiveShot окремо вимірюється вище і на тлі getMove непомітний.
+    for (int level = 1; level <= 4; ++level) {
+        AI ai(settings);
+        ai.seed(777u + level);
+        Board board(layout);
+        runner.run("AI::getMove/L" + std::to_string(level), grid, preset,
+            [&] { board = layout; ai.reset(settings); return cellCount; },
+            [&](long long) {
+                Coord c = ai.getMove(board, level);
+                board.receiveShot(c);
+                return !board.allSunk();
+            },
+            level == 4 ? 8 : 0);
+    }
+
+#ifdef SEABATTLE_BENCH_RENDER
+    {
+        const int cellPixels = 30;
+        sf::RenderTexture texture;
+        texture.create(grid * cellPixels + 4, grid * cellPixels + 4);
+        sf::Vector2f offset(2.f, 2.f);
+        Board board(layout);
+        BoardRenderer renderer;
+        renderer.draw(texture, midgame, offset, cellPixels);
+        runner.run("BoardRenderer::draw/static", grid, preset,
+            [] { return 256LL; },
+            [&](long long) { renderer.draw(texture, midgame, offset, cellPixels); return true; });
+
+        std::vector<Coord> order = cells;
+        runner.run("BoardRenderer::draw/shot", grid, preset,
+            [&] {
+                board = layout;
+                renderer.draw(texture, board, offset, cellPixels);
+                std::shuffle(order.begin(), order.end(), rng);
+                return cellCount;
+            },
+            [&](long long i) {
+                board.receiveShot(order[i]);
+                renderer.draw(texture, board, offset, cellPixels);
+                return true;
+            });
+        texture.display();
+    }
+#endif
+}
+
+bool parseRange(const char* arg, int& lo, int& hi) {
+    const char* dash = std::strchr(arg, '-');
+    lo = std::atoi(arg);
+    hi = dash ? std::atoi(dash + 1) : lo;
+    return lo >= 6 && hi <= 15 && lo <= hi;
+}
+
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (hasValue && !std::strcmp(argv[i], "--grid")) {
+            if (!parseRange(argv[++i], options.gridMin, options.gridMax)) {
+                std::cerr << "grid must be N or LO-HI within 6-15" << std::endl;
+                return 1;
+            }
+        }
+        else if (hasValue && !std::strcmp(argv[i], "--preset")) options.preset = std::atoi(argv[++i]);
+        else if (hasValue && !std::strcmp(argv[i], "--filter")) options.filter = argv[++i];
+        else if (hasValue && !std::strcmp(argv[i], "--min-time")) options.minSeconds = std::atof(argv[++i]) / 1000.0;
+        else if (hasValue && !std::strcmp(argv[i], "--budget")) options.budgetMs = std::atoi(argv[++i]);
+        else if (hasValue && !std::strcmp(argv[i], "--json")) options.jsonPath = argv[++i];
+        else {
+            std::cerr << "usage: seabattle_bench [--grid N|LO-HI] [--preset 0-2] [--filter NAME]"
+                         " [--min-time MS] [--budget MS] [--json FILE|-]" << std::endl;
+            return 1;
+        }
+    }
+    if (options.preset >= (int)PRESETS.size()) {
+        std::cerr << "preset must be 0-" << PRESETS.size() - 1 << std::endl;
+        return 1;
+    }
+
+    // З --json - у stdout іде лише JSON, таблиця переїжджає в stderr.
+    Runner runner(options, options.jsonPath == "-" ? std::cerr : std::cout);
+    for (int grid = options.gridMin; grid <= options.gridMax; ++grid)
+        for (int preset = 0; preset < (int)PRESETS.size(); ++preset)
+            if (options.preset < 0 || options.preset == preset)
+                benchConfig(runner, grid, preset);
+
+    if (options.jsonPath == "-")
+        runner.writeJson(std::cout);
+    else if (!options.jsonPath.empty()) {
+        std::ofstream out(options.jsonPath);
+        if (!out) {
+            std::cerr << "cannot write " << options.jsonPath << std::endl;
+            return 1;
+        }
+        runner.writeJson(out);
+    }
+    return checksPassed ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#include "AI.h"
+#include "GridShape.h"
+
+// Рівень 1: випадкова необстріляна клітинка.
+template <int N>
+struct AI::RandomShot {
+    typedef RandomShotFn Fn;
+    static Coord run(const Board& board, Rng& rng) {
+        const int W = GridShape<N>::WORDS;
+        BitBoard open = GridShape<N>::field() & ~(board.missCells() | board.hitCells());
+        int count = open.count<W>();
+        if (count == 0) return Coord(0, 0);
+        int i = open.nthIndex<W>(static_cast<int>(rng.below(count)));
+        return Coord(i % BIT_STRIDE, i / BIT_STRIDE);
+    }
+};
+
+AI::AI(const Settings& settings) : settings(settings) {
+    reset();
+}
+
+void AI::reset() {
+    randomShot = gridKernel<RandomShot>(settings.gridSize);
+    frontier.reset(settings.gridSize);
+    density.reset(settings.gridSize, settings.shipSet);
+}
+
+void AI::reset(const Settings& newSettings) {
+    settings = newSettings;
+    reset();
+}
+
+Coord AI::getMove(const Board& board, int aiLevel) {
+    if (aiLevel == 1)
+        return randomShot(board, rng);
+
+    if (aiLevel == 4) {
+        Coord move;
+        if (sampler.chooseMove(board, settings.shipSet, settings.aiTimeBudgetMs, rng, move))
+            return move;
+    }
+
+    if (aiLevel >= 3) {
+        density.sync(board);
+        return density.bestCell(rng);
+    }
+
+    frontier.sync(board);
+    return frontier.pick(rng);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Board.h"
+#include "DensityMap.h"
+#include "MonteCarlo.h"
+#include "Rng.h"
+#include "TargetFrontier.h"
+#include "Types.h"
+#include <cstdint>
+#include <vector>
+
+class AI {
+public:
+    AI(const Settings& settings);
+
+    void reset();
+    void reset(const Settings& newSettings);
+    Coord getMove(const Board& board, int aiLevel);
+
+    // Потік ШІ з RngService; seed(value) — те саме, що потік ШІ служби з зерном value.
+    void setRng(const Rng& stream) { rng = stream; }
+    void seed(std::uint64_t value) { rng = RngService(value).stream(RngStream::AI); }
+
+    const MonteCarloSampler& monteCarlo() const { return sampler; }
+
+private:
+    typedef Coord (*RandomShotFn)(const Board&, Rng&);
+    template <int N> struct RandomShot;
+
+    Settings settings;
+    RandomShotFn randomShot = nullptr;
+    TargetFrontier frontier;
+    DensityMap density;
+    MonteCarloSampler sampler;
+    Rng rng = RngService(RngService::freshSeed()).stream(RngStream::AI);
+};
@@ -0,0 +1,71 @@
+#include "AIWorker.h"
+
+AIWorker::AIWorker(const Settings& settings) : ai(settings), board(true, settings) {
+    thread = std::thread(&AIWorker::loop, this);
+}
+
+AIWorker::~AIWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        cancel.store(true);
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void AIWorker::startTurn(const Board& current, int aiLevel) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        board = current;
+        level = aiLevel;
+        pending = true;
+        busy.store(true, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+void AIWorker::reset(const Settings& settings, const Rng& stream) {
+    cancel.store(true);
+    std::unique_lock<std::mutex> lock(mutex);
+    // Хід, який потік ще не встиг підхопити, просто скасовується.
+    if (pending) {
+        pending = false;
+        busy.store(false, std::memory_order_release);
+    }
+    idle.wait(lock, [&] { return !busy.load(std::memory_order_acquire); });
+    cancel.store(false);
+    AIShot stale;
+    while (shots.pop(stale)) {}
+    ai.reset(settings);
+    ai.setRng(stream);
+}
+
+void AIWorker::loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return pending || stopping; });
+        if (stopping)
+            return;
+        pending = false;
+        lock.unlock();
+
+        int limit = board.getSize() * board.getSize();
+        for (int i = 0; i < limit && !cancel.load(std::memory_order_relaxed); ++i) {
+            AIShot shot;
+            shot.cell = ai.getMove(board, level);
+            shot.stats = ai.monteCarlo().lastStats();
+            shot.hit = board.receiveShot(shot.cell);
+            shot.last = !shot.hit || board.allSunk() || i + 1 == limit;
+            shots.push(shot);
+            if (shot.last)
+                break;
+        }
+
+        lock.lock();
+        // Новий хід міг надійти, поки цей завершувався.
+        if (!pending)
+            busy.store(false, std::memory_order_release);
+        idle.notify_all();
+    }
+}
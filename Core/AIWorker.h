@@ -0,0 +1,58 @@
+#pragma once
+#include "AI.h"
+#include "Board.h"
+#include "MonteCarlo.h"
+#include "SpscQueue.h"
+#include "Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Один постріл ШІ, обчислений у фоновому потоці.
+struct AIShot {
+    Coord cell;
+    bool hit = false;
+    // Останній постріл ходу: промах або потоплено весь флот.
+    bool last = false;
+    MonteCarloStats stats;
+};
+
+// Виконує хід ШІ у власному потоці на копії поля гравця. Постріли повертаються
+// потоку гри через чергу без блокувань, і гра застосовує їх до справжнього поля
+// у власному темпі, тож кадр ніколи не чекає на getMove.
+class AIWorker {
+public:
+    explicit AIWorker(const Settings& settings);
+    ~AIWorker();
+
+    AIWorker(const AIWorker&) = delete;
+    AIWorker& operator=(const AIWorker&) = delete;
+
+    // Починає хід на копії board. Усі постріли попереднього ходу вже мають бути забрані poll.
+    void startTurn(const Board& board, int level);
+    // Наступний готовий постріл, якщо він є. Викликає лише потік гри.
+    bool poll(AIShot& shot) { return shots.pop(shot); }
+    // Хід ще обчислюється (хоча частина пострілів може вже чекати в черзі).
+    bool thinking() const { return busy.load(std::memory_order_acquire); }
+
+    // Перериває поточний хід (чекає на завершення вже розпочатого getMove), відкидає
+    // незабрані постріли і скидає ШІ під нові налаштування та потік випадкових чисел.
+    void reset(const Settings& settings, const Rng& stream);
+
+private:
+    void loop();
+
+    AI ai;
+    Board board;
+    int level = 1;
+    std::mutex mutex;
+    std::condition_variable wake, idle;
+    bool pending = false;
+    bool stopping = false;
+    std::atomic<bool> busy{ false };
+    std::atomic<bool> cancel{ false };
+    // Хід не довший за кількість клітинок поля (не більше 15 * 15).
+    SpscQueue<AIShot, 256> shots;
+    std::thread thread;
+};
@@ -0,0 +1,156 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+const int MAX_GRID_SIZE = 15;
+const int BIT_STRIDE = 16;
+
+inline int popCount64(std::uint64_t v) {
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((v * 0x0101010101010101ULL) >> 56);
+}
+
+inline int lowestBit64(std::uint64_t v) {
+    static const int table[64] = {
+         0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+    };
+    return table[((v & (0 - v)) * 0x03F79D71B4CB0A89ULL) >> 58];
+}
+
+// Бітова площина поля до 15x15: клітинка (x, y) — біт y * BIT_STRIDE + x.
+// Стовпчик 15 завжди порожній, тому зсув на 1 не переносить біти між рядками.
+struct BitBoard {
+    std::array<std::uint64_t, 4> words{};
+
+    static int bitIndex(int x, int y) { return y * BIT_STRIDE + x; }
+
+    static BitBoard cell(int x, int y) {
+        BitBoard b;
+        b.set(x, y);
+        return b;
+    }
+
+    static BitBoard shipMask(int x, int y, int size, bool vertical) {
+        BitBoard b;
+        for (int i = 0; i < size; ++i)
+            b.set(x + (vertical ? 0 : i), y + (vertical ? i : 0));
+        return b;
+    }
+
+    static BitBoard fieldMask(int gridSize) {
+        BitBoard b;
+        std::uint64_t row = (1ULL << gridSize) - 1;
+        for (int y = 0; y < gridSize; ++y) {
+            int i = y * BIT_STRIDE;
+            b.words[i >> 6] |= row << (i & 63);
+        }
+        return b;
+    }
+
+    bool test(int x, int y) const {
+        int i = bitIndex(x, y);
+        return (words[i >> 6] >> (i & 63)) & 1ULL;
+    }
+    void set(int x, int y) {
+        int i = bitIndex(x, y);
+        words[i >> 6] |= 1ULL << (i & 63);
+    }
+    void reset(int x, int y) {
+        int i = bitIndex(x, y);
+        words[i >> 6] &= ~(1ULL << (i & 63));
+    }
+    void clear() { words.fill(0); }
+
+    // Параметр W у шаблонних операціях — скільки молодших слів брати до уваги.
+    // Поле N x N займає GridShape<N>::WORDS слів, старші слова в ньому завжди нульові,
+    // тож спеціалізовані під розмір поля ядра обробляють лише потрібні.
+    template <int W = 4>
+    bool any() const {
+        std::uint64_t v = 0;
+        for (int i = 0; i < W; ++i) v |= words[i];
+        return v != 0;
+    }
+    bool intersects(const BitBoard& o) const {
+        return ((words[0] & o.words[0]) | (words[1] & o.words[1]) |
+                (words[2] & o.words[2]) | (words[3] & o.words[3])) != 0;
+    }
+    template <int W = 4>
+    int count() const {
+        int c = 0;
+        for (int i = 0; i < W; ++i) c += popCount64(words[i]);
+        return c;
+    }
+
+    template <int W = 4>
+    BitBoard shl(int n) const {
+        BitBoard r;
+        int ws = n >> 6, bs = n & 63;
+        for (int i = W - 1; i >= ws; --i) {
+            std::uint64_t v = words[i - ws] << bs;
+            if (bs && i - ws > 0) v |= words[i - ws - 1] >> (64 - bs);
+            r.words[i] = v;
+        }
+        return r;
+    }
+    template <int W = 4>
+    BitBoard shr(int n) const {
+        BitBoard r;
+        int ws = n >> 6, bs = n & 63;
+        for (int i = 0; i + ws < W; ++i) {
+            std::uint64_t v = words[i + ws] >> bs;
+            if (bs && i + ws < W - 1) v |= words[i + ws + 1] << (64 - bs);
+            r.words[i] = v;
+        }
+        return r;
+    }
+
+    // Маска разом із 8 сусідами кожної клітинки, обрізана до поля.
+    template <int W = 4>
+    BitBoard grown(const BitBoard& field) const {
+        BitBoard h = *this | shl<W>(1) | shr<W>(1);
+        h = h | h.shl<W>(BIT_STRIDE) | h.shr<W>(BIT_STRIDE);
+        return h & field;
+    }
+
+    // Викликає f(x, y) для кожної встановленої клітинки в порядку рядків.
+    template <class F>
+    void forEach(F f) const {
+        for (int w = 0; w < 4; ++w) {
+            std::uint64_t v = words[w];
+            while (v) {
+                int i = w * 64 + lowestBit64(v);
+                f(i % BIT_STRIDE, i / BIT_STRIDE);
+                v &= v - 1;
+            }
+        }
+    }
+
+    // Індекс біта k-ї (з нуля) встановленої клітинки в порядку рядків; -1, якщо їх менше.
+    template <int W = 4>
+    int nthIndex(int k) const {
+        for (int w = 0; w < W; ++w) {
+            int c = popCount64(words[w]);
+            if (k < c) {
+                std::uint64_t v = words[w];
+                while (k--) v &= v - 1;
+                return w * 64 + lowestBit64(v);
+            }
+            k -= c;
+        }
+        return -1;
+    }
+
+    BitBoard operator|(const BitBoard& o) const { BitBoard r; for (int i = 0; i < 4; ++i) r.words[i] = words[i] | o.words[i]; return r; }
+    BitBoard operator&(const BitBoard& o) const { BitBoard r; for (int i = 0; i < 4; ++i) r.words[i] = words[i] & o.words[i]; return r; }
+    BitBoard operator^(const BitBoard& o) const { BitBoard r; for (int i = 0; i < 4; ++i) r.words[i] = words[i] ^ o.words[i]; return r; }
+    BitBoard operator~() const { BitBoard r; for (int i = 0; i < 4; ++i) r.words[i] = ~words[i]; return r; }
+    BitBoard& operator|=(const BitBoard& o) { for (int i = 0; i < 4; ++i) words[i] |= o.words[i]; return *this; }
+    BitBoard& operator&=(const BitBoard& o) { for (int i = 0; i < 4; ++i) words[i] &= o.words[i]; return *this; }
+    bool operator==(const BitBoard& o) const { return words == o.words; }
+    bool operator!=(const BitBoard& o) const { return words != o.words; }
+};
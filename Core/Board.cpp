@@ -0,0 +1,108 @@
+#include "Board.h"
+
+namespace {
+
+// Для викликів без явного потоку: у кожного потоку власне свіже зерно.
+Rng& defaultRng() {
+    thread_local Rng rng = RngService(RngService::freshSeed()).stream(RngStream::Board);
+    return rng;
+}
+
+}
+
+Board::Board(bool revealShips, const Settings& settings)
+    : Board(revealShips, settings, defaultRng())
+{
+}
+
+Board::Board(bool revealShips, const Settings& settings, Rng& rng)
+    : showShips(revealShips), settings(settings), table(&PlacementTable::forGrid(settings.gridSize))
+{
+    shipAt.fill(-1);
+    if (!revealShips)
+        placeAllShips(rng);
+}
+
+bool Board::placeAllShips() {
+    return placeAllShips(defaultRng());
+}
+
+bool Board::placeAllShips(Rng& rng) {
+    FleetLayout layout;
+    bool ok = FleetGenerator::shared(settings.gridSize, settings.shipSet).generate(rng, layout) == FleetStatus::Ok;
+    setLayout(layout);
+    return ok;
+}
+
+void Board::setLayout(const FleetLayout& layout) {
+    clearShips();
+    for (const auto& p : layout.ships)
+        placeShipManual(p.x, p.y, p.size, p.vertical);
+}
+
+bool Board::canPlaceShip(int x, int y, int size, bool vertical) const {
+    return fitsShip(shipPlane, missPlane | hitPlane, *table, x, y, size, vertical);
+}
+
+void Board::placeShipManual(int x, int y, int size, bool vertical) {
+    if (ships.full())
+        return;
+    Ship ship{ size, {} };
+    for (int i = 0; i < size; ++i) {
+        int nx = x + (vertical ? 0 : i);
+        int ny = y + (vertical ? i : 0);
+        shipPlane.set(nx, ny);
+        shipAt[BitBoard::bitIndex(nx, ny)] = static_cast<std::int8_t>(ships.size());
+        ship.positions.push_back(Coord(nx, ny));
+    }
+    ships.push_back(ship);
+    afloat[size]++;
+}
+
+void Board::clearShips() {
+    shipPlane.clear();
+    missPlane.clear();
+    hitPlane.clear();
+    sunkPlane.clear();
+    shipAt.fill(-1);
+    ships.clear();
+    afloat.fill(0);
+    lastSunk = -1;
+}
+
+void Board::setShips(const ShipList& newShips) {
+    clearShips();
+    ships = newShips;
+    for (size_t id = 0; id < ships.size(); ++id) {
+        if (!ships[id].sunk)
+            afloat[ships[id].size]++;
+        for (const auto& p : ships[id].positions) {
+            shipPlane.set(p.x, p.y);
+            shipAt[BitBoard::bitIndex(p.x, p.y)] = static_cast<std::int8_t>(id);
+        }
+    }
+}
+
+bool Board::receiveShot(const Coord& cell) {
+    lastSunk = -1;
+    if (cell.x < 0 || cell.x >= settings.gridSize || cell.y < 0 || cell.y >= settings.gridSize)
+        return false;
+    if (isShotCell(cell.x, cell.y))
+        return false;
+    int id = shipAt[BitBoard::bitIndex(cell.x, cell.y)];
+    if (id < 0) {
+        missPlane.set(cell.x, cell.y);
+        return false;
+    }
+    hitPlane.set(cell.x, cell.y);
+    Ship& ship = ships[id];
+    ship.hits++;
+    if (ship.hits >= ship.size) {
+        ship.sunk = true;
+        afloat[ship.size]--;
+        lastSunk = id;
+        for (const auto& p : ship.positions)
+            sunkPlane.set(p.x, p.y);
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "BitBoard.h"
+#include "FleetGenerator.h"
+#include "PlacementTable.h"
+#include "Rng.h"
+#include "Types.h"
+#include <array>
+#include <cstdint>
+
+class Board {
+public:
+    // Поле без показу кораблів одразу отримує випадкову розстановку з rng
+    // (без rng — із власного потоку поточного потоку виконання).
+    Board(bool revealShips, const Settings& settings);
+    Board(bool revealShips, const Settings& settings, Rng& rng);
+
+    // Правило розміщення: корабель у межах поля, не на заборонених клітинках
+    // і не торкається кораблів з ships навіть кутом.
+    static bool fitsShip(const BitBoard& ships, const BitBoard& forbidden, const PlacementEntry& e) {
+        return !e.mask.intersects(forbidden) && !e.halo.intersects(ships);
+    }
+    static bool fitsShip(const BitBoard& ships, const BitBoard& forbidden, const PlacementTable& table, int x, int y, int size, bool vertical) {
+        const PlacementEntry* e = table.at(x, y, size, vertical);
+        return e && fitsShip(ships, forbidden, *e);
+    }
+
+    // Випадкова розстановка всього флоту; false — флот не вміщується на полі.
+    bool placeAllShips();
+    bool placeAllShips(Rng& rng);
+    void setLayout(const FleetLayout& layout);
+    bool canPlaceShip(int x, int y, int size, bool vertical) const;
+    void placeShipManual(int x, int y, int size, bool vertical);
+    void clearShips();
+    void setShips(const ShipList& newShips);
+    bool receiveShot(const Coord& cell);
+
+    // Індекс корабля, потопленого останнім пострілом, або -1.
+    int justSunkShip() const { return lastSunk; }
+
+    bool allSunk() const {
+        return hitPlane == shipPlane;
+    }
+
+    bool isSunkCell(const Coord& cell) const {
+        if (cell.x < 0 || cell.x >= settings.gridSize || cell.y < 0 || cell.y >= settings.gridSize)
+            return false;
+        int id = shipAt[BitBoard::bitIndex(cell.x, cell.y)];
+        return id >= 0 && ships[id].sunk;
+    }
+
+    CellState cellState(int x, int y) const {
+        if (hitPlane.test(x, y)) return Hit;
+        if (missPlane.test(x, y)) return Miss;
+        if (shipPlane.test(x, y)) return ShipCell;
+        return Empty;
+    }
+
+    bool isShotCell(int x, int y) const {
+        return (missPlane | hitPlane).test(x, y);
+    }
+
+    bool isHitCell(int x, int y) const {
+        return hitPlane.test(x, y);
+    }
+
+    bool isMissCell(int x, int y) const {
+        return missPlane.test(x, y);
+    }
+
+    bool isShipCell(int x, int y) const {
+        return shipPlane.test(x, y) && !hitPlane.test(x, y);
+    }
+
+    int getSize() const { return settings.gridSize; }
+
+    const ShipList& getShips() const { return ships; }
+
+    // Залишок флоту: скільки непотоплених кораблів кожного розміру, без їхніх позицій.
+    const std::array<std::uint8_t, MAX_GRID_SIZE + 1>& remainingFleet() const { return afloat; }
+    // Розмір найменшого непотопленого корабля або 0, якщо потоплено всі.
+    int smallestAfloat() const {
+        for (int size = 1; size <= MAX_GRID_SIZE; ++size)
+            if (afloat[size])
+                return size;
+        return 0;
+    }
+
+    bool revealsShips() const { return showShips; }
+
+    const BitBoard& shipCells() const { return shipPlane; }
+    const BitBoard& missCells() const { return missPlane; }
+    const BitBoard& hitCells() const { return hitPlane; }
+    const BitBoard& sunkCells() const { return sunkPlane; }
+
+private:
+    ShipList ships;
+    bool showShips;
+    Settings settings;
+    const PlacementTable* table;
+    BitBoard shipPlane, missPlane, hitPlane, sunkPlane;
+    std::array<std::int8_t, BIT_STRIDE * BIT_STRIDE> shipAt;
+    std::array<std::uint8_t, MAX_GRID_SIZE + 1> afloat{};
+    int lastSunk = -1;
+};
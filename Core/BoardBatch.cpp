@@ -0,0 +1,176 @@
+#include "BoardBatchKernel.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SEABATTLE_BATCH_SSE2 1
+#endif
+#if defined(SEABATTLE_BATCH_AVX2) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace {
+
+#ifdef SEABATTLE_BATCH_SSE2
+struct Sse2Lanes {
+    static const int WIDTH = 2;
+    typedef __m128i V;
+    static V load(const std::uint64_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(std::uint64_t* p, V v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    static V zero() { return _mm_setzero_si128(); }
+    static V bor(V a, V b) { return _mm_or_si128(a, b); }
+    static V band(V a, V b) { return _mm_and_si128(a, b); }
+    static V bandnot(V a, V b) { return _mm_andnot_si128(b, a); }
+    static V bxor(V a, V b) { return _mm_xor_si128(a, b); }
+    template <int S> static V shl(V a) { return _mm_slli_epi64(a, S); }
+    template <int S> static V shr(V a) { return _mm_srli_epi64(a, S); }
+    // У SSE2 немає порівняння 64-бітних ліній: обидві 32-бітні половини мають бути нулями.
+    static V isZero(V a) {
+        V c = _mm_cmpeq_epi32(a, _mm_setzero_si128());
+        return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    static bool none(V a) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128())) == 0xFFFF; }
+};
+#endif
+
+#ifdef SEABATTLE_BATCH_AVX2
+bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    // OSXSAVE і AVX, і ОС зберігає регістри YMM.
+    if ((regs[2] & (1 << 27)) == 0 || (regs[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+}
+
+BoardBatch::BoardBatch() : active(bestEngine()) {
+    clear();
+}
+
+void BoardBatch::clear() {
+    std::fill(&words[0][0][0][0], &words[0][0][0][0] + CAPACITY * PLANE_COUNT * 4, 0ULL);
+    std::fill(&stepShots[0][0][0], &stepShots[0][0][0] + CAPACITY * 4, 0ULL);
+    count = 0;
+    idBits = 0;
+    usedWords = 1;
+}
+
+bool BoardBatch::add(const Board& board) {
+    const ShipList& ships = board.getShips();
+    if (count == CAPACITY || ships.size() > (1u << ID_BITS))
+        return false;
+    BlockWords& block = words[count / BLOCK];
+    int slot = count % BLOCK;
+    const BitBoard* source[4] = { &board.shipCells(), &board.missCells(), &board.hitCells(), &board.sunkCells() };
+    for (int p = 0; p < 4; ++p)
+        for (int w = 0; w < 4; ++w)
+            block[p][w][slot] = source[p]->words[w];
+    for (int k = 0; k < ID_BITS; ++k)
+        for (int w = 0; w < 4; ++w)
+            block[ShipId + k][w][slot] = 0;
+    for (size_t id = 0; id < ships.size(); ++id) {
+        for (const auto& p : ships[id].positions) {
+            int bit = BitBoard::bitIndex(p.x, p.y);
+            for (int k = 0; k < ID_BITS; ++k)
+                if (id >> k & 1)
+                    block[ShipId + k][bit >> 6][slot] |= 1ULL << (bit & 63);
+        }
+        while ((id >> idBits) != 0)
+            ++idBits;
+    }
+    gridSizes[count] = static_cast<std::uint8_t>(board.getSize());
+    usedWords = std::max(usedWords, (board.getSize() * BIT_STRIDE + 63) / 64);
+    ++count;
+    return true;
+}
+
+void BoardBatch::receiveShots(const Coord* shots, bool* hit) {
+    // Без розгалужень: постріли випадкові, і перевірка меж інакше постійно не вгадується.
+    for (int i = 0; i < count; ++i) {
+        std::uint64_t (&shot)[4][BLOCK] = stepShots[i / BLOCK];
+        int slot = i % BLOCK;
+        unsigned n = gridSizes[i];
+        const Coord& c = shots[i];
+        std::uint64_t inside = static_cast<unsigned>(c.x) < n && static_cast<unsigned>(c.y) < n;
+        int bit = BitBoard::bitIndex(c.x, c.y) & (BIT_STRIDE * BIT_STRIDE - 1);
+        std::uint64_t mask = inside << (bit & 63);
+        int word = bit >> 6;
+        for (int w = 0; w < usedWords; ++w)
+            shot[w][slot] = w == word ? mask : 0;
+    }
+    alignas(32) std::uint64_t hitMask[CAPACITY];
+    switch (active) {
+#ifdef SEABATTLE_BATCH_AVX2
+    case BatchEngine::Avx2: shootAllAvx2(usedWords, words, stepShots, count, idBits, hitMask); break;
+#endif
+#ifdef SEABATTLE_BATCH_SSE2
+    case BatchEngine::Sse2: shootAllWords<Sse2Lanes>(usedWords, words, stepShots, count, idBits, hitMask); break;
+#endif
+    default: shootAllWords<ScalarLanes>(usedWords, words, stepShots, count, idBits, hitMask); break;
+    }
+    for (int i = 0; i < count; ++i)
+        hit[i] = hitMask[i] != 0;
+}
+
+int BoardBatch::allSunk(bool* done) const {
+    alignas(32) std::uint64_t doneMask[CAPACITY];
+    switch (active) {
+#ifdef SEABATTLE_BATCH_AVX2
+    case BatchEngine::Avx2: sunkAllAvx2(usedWords, words, count, doneMask); break;
+#endif
+#ifdef SEABATTLE_BATCH_SSE2
+    case BatchEngine::Sse2: sunkAllWords<Sse2Lanes>(usedWords, words, count, doneMask); break;
+#endif
+    default: sunkAllWords<ScalarLanes>(usedWords, words, count, doneMask); break;
+    }
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+        done[i] = doneMask[i] != 0;
+        total += done[i];
+    }
+    return total;
+}
+
+BitBoard BoardBatch::plane(Plane p, int i) const {
+    BitBoard b;
+    for (int w = 0; w < 4; ++w)
+        b.words[w] = words[i / BLOCK][p][w][i % BLOCK];
+    return b;
+}
+
+BatchEngine BoardBatch::bestEngine() {
+#if defined(SEABATTLE_BATCH_AVX2)
+    static const bool avx2 = cpuHasAvx2();
+    if (avx2)
+        return BatchEngine::Avx2;
+#endif
+#if defined(SEABATTLE_BATCH_SSE2)
+    return BatchEngine::Sse2;
+#else
+    return BatchEngine::Scalar;
+#endif
+}
+
+void BoardBatch::setEngine(BatchEngine e) {
+    active = static_cast<int>(e) <= static_cast<int>(bestEngine()) ? e : bestEngine();
+}
+
+const char* BoardBatch::engineName(BatchEngine e) {
+    switch (e) {
+    case BatchEngine::Avx2: return "avx2";
+    case BatchEngine::Sse2: return "sse2";
+    default: return "scalar";
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "BitBoard.h"
+#include "Board.h"
+#include "Types.h"
+#include <cstdint>
+
+enum class BatchEngine { Scalar, Sse2, Avx2 };
+
+// Площини кораблів і пострілів багатьох незалежних полів для масових симуляцій.
+// Поля згруповані по BLOCK: слово w площини всіх полів блоку лежить поспіль, тож
+// один SIMD-регістр обробляє одне слово кількох полів (AVX2 — 4, SSE2 — 2, інакше 1),
+// а всі площини блоку займають кілька сусідніх рядків кешу.
+// Правила ті самі, що в Board::receiveShot: номер корабля в кожній клітинці
+// зберігається побітово в площинах ID_BITS, тож потоплення визначається так само,
+// як через Board::shipAt, а не за зв'язністю клітинок.
+// Пакетно застосовуються лише постріли; виграш над Board дає тільки AVX2, SSE2 йде
+// з ним приблизно врівень, а 64-бітний шлях повільніший.
+// Об'єкт займає близько 80 КБ, тож його краще створювати в купі.
+class BoardBatch {
+public:
+    static const int CAPACITY = 256;
+    static const int BLOCK = 4;
+    // До 2^ID_BITS кораблів на полі.
+    static const int ID_BITS = 5;
+    static_assert(MAX_FLEET_SIZE <= 1 << ID_BITS, "ship ids must fit in ID_BITS planes");
+
+    // Площини в пам'яті батчу: ShipId + k — біт k номера корабля.
+    enum Plane { Ships, Misses, Hits, Sunk, ShipId, PLANE_COUNT = ShipId + ID_BITS };
+
+    BoardBatch();
+
+    int size() const { return count; }
+    void clear();
+
+    // Копіює розстановку і постріли поля. false — батч повний або кораблів забагато.
+    bool add(const Board& board);
+
+    // Постріл у shots[i] для кожного поля i; координати поза полем ігноруються.
+    // hit[i] — те саме, що повернув би Board::receiveShot.
+    void receiveShots(const Coord* shots, bool* hit);
+
+    // done[i] — усі кораблі поля i потоплені. Повертає кількість таких полів.
+    int allSunk(bool* done) const;
+
+    BitBoard shipCells(int i) const { return plane(Ships, i); }
+    BitBoard missCells(int i) const { return plane(Misses, i); }
+    BitBoard hitCells(int i) const { return plane(Hits, i); }
+    BitBoard sunkCells(int i) const { return plane(Sunk, i); }
+
+    BatchEngine engine() const { return active; }
+    // Найшвидший рушій, доступний у цій збірці на цьому процесорі (AVX2 вибирається під час
+    // виконання); менші теж можна ввімкнути для перевірки.
+    static BatchEngine bestEngine();
+    void setEngine(BatchEngine e);
+    static const char* engineName(BatchEngine e);
+
+    BitBoard plane(Plane p, int i) const;
+
+private:
+    alignas(32) std::uint64_t words[CAPACITY / BLOCK][PLANE_COUNT][4][BLOCK];
+    // Постріли поточного кроку окремо від площин: 8 КБ, що лишаються в L1 між кроками.
+    alignas(32) std::uint64_t stepShots[CAPACITY / BLOCK][4][BLOCK];
+    std::uint8_t gridSizes[CAPACITY];
+    int count = 0;
+    // Скільки площин номера корабля потрібно для найбільшого флоту в батчі.
+    int idBits = 0;
+    // Скільки перших слів площини зайнято найбільшим полем батчу (рядок — BIT_STRIDE біт).
+    int usedWords = 1;
+    BatchEngine active;
+};
@@ -0,0 +1,36 @@
+#include "BoardBatchKernel.h"
+
+#ifdef SEABATTLE_BATCH_AVX2
+#if defined(__GNUC__) && !defined(__AVX2__)
+#error "BoardBatchAvx2.cpp must be compiled with -mavx2"
+#endif
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Lanes {
+    static const int WIDTH = 4;
+    typedef __m256i V;
+    static V load(const std::uint64_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(std::uint64_t* p, V v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    static V zero() { return _mm256_setzero_si256(); }
+    static V bor(V a, V b) { return _mm256_or_si256(a, b); }
+    static V band(V a, V b) { return _mm256_and_si256(a, b); }
+    static V bandnot(V a, V b) { return _mm256_andnot_si256(b, a); }
+    static V bxor(V a, V b) { return _mm256_xor_si256(a, b); }
+    template <int S> static V shl(V a) { return _mm256_slli_epi64(a, S); }
+    template <int S> static V shr(V a) { return _mm256_srli_epi64(a, S); }
+    static V isZero(V a) { return _mm256_cmpeq_epi64(a, _mm256_setzero_si256()); }
+    static bool none(V a) { return _mm256_testz_si256(a, a) != 0; }
+};
+
+}
+
+void shootAllAvx2(int words, BlockWords* blocks, const ShotWords* shots, int count, int idBits, std::uint64_t* hitOut) {
+    shootAllWords<Avx2Lanes>(words, blocks, shots, count, idBits, hitOut);
+}
+
+void sunkAllAvx2(int words, const BlockWords* blocks, int count, std::uint64_t* doneOut) {
+    sunkAllWords<Avx2Lanes>(words, blocks, count, doneOut);
+}
+#endif
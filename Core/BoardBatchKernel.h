@@ -0,0 +1,149 @@
+#pragma once
+#include "BoardBatch.h"
+#include <cstdint>
+
+// Ядро BoardBatch для BoardBatch.cpp і BoardBatchAvx2.cpp. Друга збирається з -mavx2
+// (MSVC x64 — без ключів, інтринсики там доступні й так), а вибирає її BoardBatch::bestEngine
+// лише на процесорах з AVX2. Шаблони в анонімному просторі імен: кожна одиниця трансляції
+// має власну копію під свій набір інструкцій, і компонувальник не підставить AVX2-версію
+// у код для решти процесорів.
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || (defined(_MSC_VER) && defined(_M_X64))
+#define SEABATTLE_BATCH_AVX2 1
+#endif
+
+typedef std::uint64_t BlockWords[BoardBatch::PLANE_COUNT][4][BoardBatch::BLOCK];
+typedef std::uint64_t ShotWords[4][BoardBatch::BLOCK];
+
+#ifdef SEABATTLE_BATCH_AVX2
+void shootAllAvx2(int words, BlockWords* blocks, const ShotWords* shots, int count, int idBits, std::uint64_t* hitOut);
+void sunkAllAvx2(int words, const BlockWords* blocks, int count, std::uint64_t* doneOut);
+#endif
+
+namespace {
+
+// Однаковий набір операцій над 64-бітними лінями для кожного рушія;
+// ядро нижче написане один раз як шаблон над ним.
+struct ScalarLanes {
+    static const int WIDTH = 1;
+    typedef std::uint64_t V;
+    static V load(const std::uint64_t* p) { return *p; }
+    static void store(std::uint64_t* p, V v) { *p = v; }
+    static V zero() { return 0; }
+    static V bor(V a, V b) { return a | b; }
+    static V band(V a, V b) { return a & b; }
+    // a & ~b
+    static V bandnot(V a, V b) { return a & ~b; }
+    static V bxor(V a, V b) { return a ^ b; }
+    template <int S> static V shl(V a) { return a << S; }
+    template <int S> static V shr(V a) { return a >> S; }
+    // Усі одиниці в лінях, де a == 0.
+    static V isZero(V a) { return a ? 0 : ~0ULL; }
+    static bool none(V a) { return a == 0; }
+};
+
+// Один постріл у кожне поле групи з L::WIDTH полів блоку, починаючи з місця slot.
+// W — скільки перших слів площини зайнято найбільшим полем батчу; решта завжди нулі.
+template <class L, int W>
+void shootGroup(BlockWords& block, const ShotWords& shots, int slot, int idBits, std::uint64_t* hitOut) {
+    typedef typename L::V V;
+    V ship[W], hit[W], fresh[W], anyHit = L::zero();
+    for (int w = 0; w < W; ++w) {
+        ship[w] = L::load(&block[BoardBatch::Ships][w][slot]);
+        hit[w] = L::load(&block[BoardBatch::Hits][w][slot]);
+        V miss = L::load(&block[BoardBatch::Misses][w][slot]);
+        // Повторний постріл у ту саму клітинку нічого не змінює.
+        V shot = L::bandnot(L::load(&shots[w][slot]), L::bor(miss, hit[w]));
+        fresh[w] = L::band(shot, ship[w]);
+        hit[w] = L::bor(hit[w], fresh[w]);
+        anyHit = L::bor(anyHit, fresh[w]);
+        L::store(&block[BoardBatch::Hits][w][slot], hit[w]);
+        L::store(&block[BoardBatch::Misses][w][slot], L::bor(miss, L::bandnot(shot, ship[w])));
+    }
+    L::store(hitOut, anyHit);
+    if (L::none(anyHit))
+        return;
+
+    // Клітинки корабля, у який влучили: номер збігається з номером у клітинці
+    // влучання в кожній площині номера.
+    V part[W];
+    for (int w = 0; w < W; ++w)
+        part[w] = ship[w];
+    for (int k = 0; k < idBits; ++k) {
+        V id[W], bit = L::zero();
+        for (int w = 0; w < W; ++w) {
+            id[w] = L::load(&block[BoardBatch::ShipId + k][w][slot]);
+            bit = L::bor(bit, L::band(id[w], fresh[w]));
+        }
+        // id ^ ~b: одиниці там, де біт номера клітинки збігається з бітом b корабля.
+        V notBit = L::isZero(bit);
+        for (int w = 0; w < W; ++w)
+            part[w] = L::band(part[w], L::bxor(id[w], notBit));
+    }
+    V afloat = L::zero();
+    for (int w = 0; w < W; ++w)
+        afloat = L::bor(afloat, L::bandnot(part[w], hit[w]));
+    V sinks = L::bandnot(L::isZero(afloat), L::isZero(anyHit));
+    for (int w = 0; w < W; ++w) {
+        std::uint64_t* sunk = &block[BoardBatch::Sunk][w][slot];
+        L::store(sunk, L::bor(L::load(sunk), L::band(part[w], sinks)));
+    }
+}
+
+template <class L, int W>
+void sunkGroup(const BlockWords& block, int slot, std::uint64_t* doneOut) {
+    typename L::V diff = L::zero();
+    for (int w = 0; w < W; ++w)
+        diff = L::bor(diff, L::bxor(L::load(&block[BoardBatch::Ships][w][slot]), L::load(&block[BoardBatch::Hits][w][slot])));
+    L::store(doneOut, L::isZero(diff));
+}
+
+// Повні групи — векторно, хвіст останнього блоку — по одному полю,
+// щоб не чіпати незаповнені місця.
+template <class L, class Block, class Group>
+void forGroups(Block* blocks, int count, Group group) {
+    int vectorEnd = count - count % L::WIDTH;
+    for (int i = 0; i < vectorEnd; i += L::WIDTH)
+        group(blocks[i / BoardBatch::BLOCK], i % BoardBatch::BLOCK, i, L::WIDTH);
+    for (int i = vectorEnd; i < count; ++i)
+        group(blocks[i / BoardBatch::BLOCK], i % BoardBatch::BLOCK, i, 1);
+}
+
+template <class L, int W>
+void shootAll(BlockWords* blocks, const ShotWords* shots, int count, int idBits, std::uint64_t* hitOut) {
+    forGroups<L>(blocks, count, [&](BlockWords& block, int slot, int i, int width) {
+        const ShotWords& s = shots[i / BoardBatch::BLOCK];
+        if (width == L::WIDTH) shootGroup<L, W>(block, s, slot, idBits, hitOut + i);
+        else shootGroup<ScalarLanes, W>(block, s, slot, idBits, hitOut + i);
+    });
+}
+
+template <class L, int W>
+void sunkAll(const BlockWords* blocks, int count, std::uint64_t* doneOut) {
+    forGroups<L>(blocks, count, [&](const BlockWords& block, int slot, int i, int width) {
+        if (width == L::WIDTH) sunkGroup<L, W>(block, slot, doneOut + i);
+        else sunkGroup<ScalarLanes, W>(block, slot, doneOut + i);
+    });
+}
+
+// Ядро під зайняту кількість слів: 2 для полів до 8x8, 3 — до 12x12, інакше 4.
+template <class L>
+void shootAllWords(int words, BlockWords* blocks, const ShotWords* shots, int count, int idBits, std::uint64_t* hitOut) {
+    switch (words) {
+    case 1: shootAll<L, 1>(blocks, shots, count, idBits, hitOut); break;
+    case 2: shootAll<L, 2>(blocks, shots, count, idBits, hitOut); break;
+    case 3: shootAll<L, 3>(blocks, shots, count, idBits, hitOut); break;
+    default: shootAll<L, 4>(blocks, shots, count, idBits, hitOut); break;
+    }
+}
+
+template <class L>
+void sunkAllWords(int words, const BlockWords* blocks, int count, std::uint64_t* doneOut) {
+    switch (words) {
+    case 1: sunkAll<L, 1>(blocks, count, doneOut); break;
+    case 2: sunkAll<L, 2>(blocks, count, doneOut); break;
+    case 3: sunkAll<L, 3>(blocks, count, doneOut); break;
+    default: sunkAll<L, 4>(blocks, count, doneOut); break;
+    }
+}
+
+}
@@ -0,0 +1,162 @@
+#include "DensityMap.h"
+#include <algorithm>
+
+namespace {
+
+// Вага розміщення — remaining << (4 * overlap), і сума ваг по клітинці мусить вміститися
+// в long long: remaining <= 32, розміщень через клітинку < 256, кожне додається не більше
+// 15 разів (раз на влучання), тож перекриття понад 11 рахуються як 11.
+const int MAX_WEIGHTED_OVERLAP = 11;
+
+}
+
+void DensityMap::reset(int newGridSize, const ShipSet& newFleet) {
+    gridSize = newGridSize;
+    fleet = newFleet;
+    table = &PlacementTable::forGrid(gridSize);
+    field = table->field();
+    blocked.clear();
+    seenMiss.clear();
+    seenHit.clear();
+    seenSunk.clear();
+    density.fill(0);
+    classes.clear();
+
+    ShipSet sizes = fleet;
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+    for (int size : sizes) {
+        if (size <= 0 || size > gridSize)
+            continue;
+        classes.resize(classes.size() + 1);
+        SizeClass& sc = classes.back();
+        sc.size = size;
+        sc.remaining = static_cast<int>(std::count(fleet.begin(), fleet.end(), size));
+        std::fill(sc.alive.begin(), sc.alive.begin() + table->all(size).size(), 1);
+        field.forEach([&](int x, int y) {
+            int cell = BitBoard::bitIndex(x, y);
+            sc.cover[cell] = static_cast<int>(table->covering(size, cell).size());
+            density[cell] += sc.cover[cell] * sc.remaining;
+        });
+    }
+}
+
+void DensityMap::block(int x, int y) {
+    if (blocked.test(x, y))
+        return;
+    blocked.set(x, y);
+    int cell = BitBoard::bitIndex(x, y);
+    for (auto& sc : classes) {
+        const auto& entries = table->all(sc.size);
+        for (std::uint16_t idx : table->covering(sc.size, cell)) {
+            if (!sc.alive[idx])
+                continue;
+            sc.alive[idx] = 0;
+            entries[idx].mask.forEach([&](int px, int py) {
+                int c = BitBoard::bitIndex(px, py);
+                sc.cover[c]--;
+                density[c] -= sc.remaining;
+            });
+        }
+    }
+}
+
+void DensityMap::sinkShip(int size) {
+    for (auto& sc : classes) {
+        if (sc.size != size || sc.remaining == 0)
+            continue;
+        sc.remaining--;
+        field.forEach([&](int x, int y) {
+            int c = BitBoard::bitIndex(x, y);
+            density[c] -= sc.cover[c];
+        });
+        return;
+    }
+}
+
+void DensityMap::sync(const Board& board) {
+    if (board.getSize() != gridSize ||
+        (seenMiss & ~board.missCells()).any() || (seenHit & ~board.hitCells()).any())
+        reset(board.getSize(), fleet);
+
+    BitBoard newMiss = board.missCells() & ~seenMiss;
+    BitBoard newHit = board.hitCells() & ~seenHit;
+    BitBoard newSunk = board.sunkCells() & ~seenSunk;
+    seenMiss = board.missCells();
+    seenHit = board.hitCells();
+    seenSunk = board.sunkCells();
+
+    newMiss.forEach([&](int x, int y) { block(x, y); });
+
+    // Кораблі не торкаються, тож діагональні сусіди влучання завжди порожні.
+    newHit.forEach([&](int x, int y) {
+        const int d[4][2] = { {-1,-1},{1,-1},{-1,1},{1,1} };
+        for (const auto& o : d) {
+            int nx = x + o[0], ny = y + o[1];
+            if (nx >= 0 && ny >= 0 && nx < gridSize && ny < gridSize)
+                block(nx, ny);
+        }
+    });
+
+    // Нові потоплені клітинки розбиваються на кораблі за ортогональною зв'язністю.
+    while (newSunk.any()) {
+        BitBoard ship;
+        newSunk.forEach([&](int x, int y) { if (!ship.any()) ship.set(x, y); });
+        for (;;) {
+            BitBoard grownShip = (ship | ship.shl(1) | ship.shr(1) | ship.shl(BIT_STRIDE) | ship.shr(BIT_STRIDE)) & newSunk;
+            if (grownShip == ship) break;
+            ship = grownShip;
+        }
+        newSunk = newSunk & ~ship;
+        sinkShip(ship.count());
+        ship.grown(field).forEach([&](int x, int y) { block(x, y); });
+    }
+}
+
+Coord DensityMap::bestCell(Rng& rng) const {
+    BitBoard shot = seenMiss | seenHit;
+    BitBoard wounded = seenHit & ~seenSunk;
+
+    std::array<long long, BIT_STRIDE * BIT_STRIDE> score{};
+    if (wounded.any()) {
+        // Розміщення, що накривають більше влучань, значно ймовірніші.
+        for (const auto& sc : classes) {
+            if (sc.remaining == 0)
+                continue;
+            const auto& entries = table->all(sc.size);
+            wounded.forEach([&](int hx, int hy) {
+                for (std::uint16_t idx : table->covering(sc.size, BitBoard::bitIndex(hx, hy))) {
+                    if (!sc.alive[idx])
+                        continue;
+                    const BitBoard& mask = entries[idx].mask;
+                    int overlap = std::min((mask & wounded).count(), MAX_WEIGHTED_OVERLAP);
+                    long long weight = static_cast<long long>(sc.remaining) << (4 * overlap);
+                    (mask & ~shot).forEach([&](int x, int y) { score[BitBoard::bitIndex(x, y)] += weight; });
+                }
+            });
+        }
+    }
+    else {
+        field.forEach([&](int x, int y) {
+            int c = BitBoard::bitIndex(x, y);
+            score[c] = density[c];
+        });
+    }
+
+    Coord best(-1, -1);
+    long long bestScore = -1;
+    int ties = 0;
+    (field & ~shot).forEach([&](int x, int y) {
+        long long sc = score[BitBoard::bitIndex(x, y)];
+        if (sc > bestScore) {
+            bestScore = sc;
+            best = Coord(x, y);
+            ties = 1;
+        }
+        else if (sc == bestScore && rng.below(++ties) == 0) {
+            best = Coord(x, y);
+        }
+    });
+    return best.x < 0 ? Coord(0, 0) : best;
+}
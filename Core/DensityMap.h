@@ -0,0 +1,44 @@
+#pragma once
+#include "BitBoard.h"
+#include "Board.h"
+#include "PlacementTable.h"
+#include "Rng.h"
+#include "Types.h"
+#include <array>
+#include <cstdint>
+
+// Карта щільності для ШІ рівня 3: для кожної клітинки — скільки допустимих розміщень
+// ще не потоплених кораблів її накривають. Оновлюється інкрементно: постріл чи потоплення
+// вимикає лише розміщення, що проходять через заблоковані клітинки.
+class DensityMap {
+public:
+    void reset(int gridSize, const ShipSet& fleet);
+
+    // Враховує постріли, зроблені по полю після попереднього виклику.
+    void sync(const Board& board);
+
+    // Найщільніша необстріляна клітинка; якщо є поранений корабель — добиває його.
+    Coord bestCell(Rng& rng) const;
+
+    int densityAt(int x, int y) const { return density[BitBoard::bitIndex(x, y)]; }
+
+private:
+    struct SizeClass {
+        int size = 0;
+        int remaining = 0;
+        std::array<std::uint8_t, MAX_PLACEMENTS> alive;
+        std::array<int, BIT_STRIDE * BIT_STRIDE> cover{};
+    };
+
+    void block(int x, int y);
+    void sinkShip(int size);
+
+    int gridSize = 0;
+    const PlacementTable* table = nullptr;
+    ShipSet fleet;
+    FixedVector<SizeClass, MAX_GRID_SIZE> classes;
+    std::array<int, BIT_STRIDE * BIT_STRIDE> density{};
+    BitBoard field;
+    BitBoard blocked;
+    BitBoard seenMiss, seenHit, seenSunk;
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+// Вектор із місткістю, заданою під час компіляції: елементи живуть усередині об'єкта,
+// тож копіювання, очищення й додавання ніколи не звертаються до купи.
+// Як і SpscQueue, при переповненні не кидає виняток: push_back повертає false.
+template <class T, std::size_t Capacity>
+class FixedVector {
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    FixedVector() {}
+    FixedVector(std::initializer_list<T> init) {
+        for (const T& v : init)
+            push_back(v);
+    }
+
+    static std::size_t capacity() { return Capacity; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+
+    bool push_back(const T& value) {
+        if (count == Capacity)
+            return false;
+        items[count++] = value;
+        return true;
+    }
+    void pop_back() { --count; }
+    void clear() { count = 0; }
+    // Нові елементи отримують значення value; зайві відкидаються.
+    void resize(std::size_t n, const T& value = T()) {
+        if (n > Capacity)
+            n = Capacity;
+        for (std::size_t i = count; i < n; ++i)
+            items[i] = value;
+        count = n;
+    }
+    iterator erase(const_iterator pos) {
+        iterator p = begin() + (pos - begin());
+        for (iterator q = p; q + 1 != end(); ++q)
+            *q = *(q + 1);
+        --count;
+        return p;
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        iterator p = begin() + (first - begin());
+        std::size_t gap = last - first;
+        for (iterator q = p; q + gap != end(); ++q)
+            *q = *(q + gap);
+        count -= gap;
+        return p;
+    }
+
+    T& operator[](std::size_t i) { return items[i]; }
+    const T& operator[](std::size_t i) const { return items[i]; }
+    T& front() { return items[0]; }
+    const T& front() const { return items[0]; }
+    T& back() { return items[count - 1]; }
+    const T& back() const { return items[count - 1]; }
+    T* data() { return items.data(); }
+    const T* data() const { return items.data(); }
+
+    iterator begin() { return items.data(); }
+    iterator end() { return items.data() + count; }
+    const_iterator begin() const { return items.data(); }
+    const_iterator end() const { return items.data() + count; }
+
+    bool operator==(const FixedVector& o) const {
+        if (count != o.count)
+            return false;
+        for (std::size_t i = 0; i < count; ++i)
+            if (!(items[i] == o.items[i]))
+                return false;
+        return true;
+    }
+    bool operator!=(const FixedVector& o) const { return !(*this == o); }
+
+private:
+    std::array<T, Capacity> items{};
+    std::size_t count = 0;
+};
@@ -0,0 +1,215 @@
+#include "FleetGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+FleetGenerator::FleetGenerator(int gridSize, const ShipSet& fleet)
+    : FleetGenerator(gridSize, fleet, true)
+{
+}
+
+FleetGenerator::FleetGenerator(int gridSize, const ShipSet& fleet, bool withTable)
+    : gridSize(gridSize), fleet(fleet), order(fleet)
+{
+    std::sort(order.begin(), order.end(), std::greater<int>());
+    const PlacementTable& table = PlacementTable::forGrid(gridSize);
+    for (int size : order) {
+        if (size <= 0 || size > gridSize) {
+            mode = Stopped;
+            feasibility = FleetStatus::Infeasible;
+            candidates.clear();
+            return;
+        }
+        candidates.push_back(&table.all(size));
+    }
+    int accepted = probeSampling();
+    if (accepted >= PROBE_MIN_ACCEPTED)
+        return;
+    // Щільний флот: вибірка з відкиданням рівномірна, але повільна, тож generate бере
+    // пропозиції з таблиці. Якщо проба нічого не знайшла, існування доводить обмежений пошук.
+    feasibility = accepted > 0 ? FleetStatus::Ok : proveFeasible();
+    mode = Stopped;
+    if (feasibility == FleetStatus::Ok && withTable) {
+        buildTable();
+        mode = Table;
+    }
+}
+
+FleetGenerator& FleetGenerator::shared(int gridSize, const ShipSet& fleet) {
+    thread_local std::unique_ptr<FleetGenerator> cached;
+    if (!cached || cached->gridSize != gridSize || cached->fleet != fleet)
+        cached.reset(new FleetGenerator(gridSize, fleet));
+    return *cached;
+}
+
+FleetStatus FleetGenerator::check(int gridSize, const ShipSet& fleet) {
+    return FleetGenerator(gridSize, fleet, false).status();
+}
+
+int FleetGenerator::probeSampling() const {
+    Rng probe;
+    Picks picks;
+    int accepted = 0;
+    for (int i = 0; i < PROBE_ATTEMPTS; ++i)
+        accepted += sampleOnce(probe, picks) ? 1 : 0;
+    return accepted;
+}
+
+struct FleetGenerator::SearchBudget {
+    long long nodes = 0;
+    std::chrono::steady_clock::time_point deadline;
+    bool exhausted = false;
+
+    bool spend() {
+        if (++nodes > FEASIBILITY_NODE_LIMIT || ((nodes & 4095) == 0 && std::chrono::steady_clock::now() > deadline))
+            exhausted = true;
+        return !exhausted;
+    }
+};
+
+// Пошук із поверненням лише відповідає на питання «чи вміщується флот»: розстановки,
+// які він знаходить, зміщені, тому в generate вони не потрапляють.
+FleetStatus FleetGenerator::proveFeasible() const {
+    SearchBudget budget;
+    budget.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(FEASIBILITY_TIME_MS);
+    if (searchFrom(0, 0, BitBoard(), budget))
+        return FleetStatus::Ok;
+    return budget.exhausted ? FleetStatus::Undecided : FleetStatus::Infeasible;
+}
+
+bool FleetGenerator::searchFrom(size_t ship, int minIdx, const BitBoard& occupied, SearchBudget& budget) const {
+    if (ship == order.size())
+        return true;
+    const auto& list = *candidates[ship];
+    for (int idx = minIdx; idx < static_cast<int>(list.size()); ++idx) {
+        if (!budget.spend())
+            return false;
+        if (list[idx].halo.intersects(occupied))
+            continue;
+        int nextMin = (ship + 1 < order.size() && order[ship + 1] == order[ship]) ? idx + 1 : 0;
+        if (searchFrom(ship + 1, nextMin, occupied | list[idx].mask, budget))
+            return true;
+        if (budget.exhausted)
+            return false;
+    }
+    return false;
+}
+
+void FleetGenerator::buildLayout(const std::uint16_t* picks, FleetLayout& out) const {
+    out.ships.clear();
+    out.cells.clear();
+    for (size_t i = 0; i < order.size(); ++i) {
+        const PlacementEntry& c = (*candidates[i])[picks[i]];
+        out.ships.push_back(ShipPlacement{ c.x, c.y, static_cast<std::uint8_t>(order[i]), c.vertical });
+        out.cells |= c.mask;
+    }
+}
+
+bool FleetGenerator::sampleOnce(Rng& rng, Picks& picks) const {
+    BitBoard occupied;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const auto& list = *candidates[i];
+        auto idx = static_cast<std::uint16_t>(rng.below(static_cast<std::uint32_t>(list.size())));
+        if (list[idx].halo.intersects(occupied))
+            return false;
+        occupied |= list[idx].mask;
+        picks[i] = idx;
+    }
+    return true;
+}
+
+// Кораблі однакового розміру перебираються у зростаючому порядку індексів,
+// тож кожна розстановка перших depth кораблів потрапляє в таблицю рівно один раз.
+bool FleetGenerator::enumerateFrom(size_t ship, size_t depth, int minIdx, const BitBoard& occupied, Picks& picks, long long& nodes) {
+    if (ship == depth) {
+        if (table.size() + depth > TABLE_LIMIT * depth)
+            return false;
+        table.insert(table.end(), picks.begin(), picks.begin() + depth);
+        return true;
+    }
+    const auto& list = *candidates[ship];
+    for (int idx = minIdx; idx < static_cast<int>(list.size()); ++idx) {
+        if (++nodes > ENUMERATION_NODE_LIMIT)
+            return false;
+        if (list[idx].halo.intersects(occupied))
+            continue;
+        picks[ship] = static_cast<std::uint16_t>(idx);
+        int nextMin = (ship + 1 < depth && order[ship + 1] == order[ship]) ? idx + 1 : 0;
+        if (!enumerateFrom(ship + 1, depth, nextMin, occupied | list[idx].mask, picks, nodes))
+            return false;
+    }
+    return true;
+}
+
+// Таблиця для найбільшої глибини, що вкладається в ліміти. Неповна таблиця — це пропозиція
+// для відкидання: префікс рівномірно з таблиці, решта кораблів — незалежно. Кожна допустима
+// розстановка має однакову кількість представлень (префікс, решта), тож вибір лишається рівномірним.
+void FleetGenerator::buildTable() {
+    std::vector<std::uint16_t> best;
+    size_t bestDepth = 0;
+    for (size_t depth = 1; depth <= order.size(); ++depth) {
+        table.clear();
+        Picks picks{};
+        long long nodes = 0;
+        if (!enumerateFrom(0, depth, 0, BitBoard(), picks, nodes))
+            break;
+        best.swap(table);
+        bestDepth = depth;
+    }
+    table.swap(best);
+    table.shrink_to_fit();
+    tableDepth = bestDepth;
+}
+
+bool FleetGenerator::sampleFromTable(Rng& rng, Picks& picks) const {
+    size_t count = table.size() / tableDepth;
+    const std::uint16_t* prefix = &table[rng.below(static_cast<std::uint32_t>(count)) * tableDepth];
+    BitBoard occupied;
+    for (size_t i = 0; i < tableDepth; ++i) {
+        picks[i] = prefix[i];
+        occupied |= (*candidates[i])[prefix[i]].mask;
+    }
+    for (size_t i = tableDepth; i < order.size(); ++i) {
+        const auto& list = *candidates[i];
+        auto idx = static_cast<std::uint16_t>(rng.below(static_cast<std::uint32_t>(list.size())));
+        if (list[idx].halo.intersects(occupied))
+            return false;
+        occupied |= list[idx].mask;
+        picks[i] = idx;
+    }
+    return true;
+}
+
+FleetStatus FleetGenerator::generate(Rng& rng, FleetLayout& out) {
+    // Розстановка точно існує, тож відкидання завершується й лишається рівномірним.
+    Picks picks;
+    if (mode == Sampling) {
+        while (!sampleOnce(rng, picks)) {}
+        buildLayout(picks.data(), out);
+        return FleetStatus::Ok;
+    }
+    if (mode == Table) {
+        for (long long a = 0; a < TABLE_ATTEMPT_LIMIT; ++a) {
+            if (sampleFromTable(rng, picks)) {
+                buildLayout(picks.data(), out);
+                return FleetStatus::Ok;
+            }
+        }
+    }
+
+    out.ships.clear();
+    out.cells.clear();
+    return mode == Table ? FleetStatus::Undecided : feasibility;
+}
+
+size_t FleetGenerator::generateBulk(Rng& rng, size_t count, std::vector<FleetLayout>& out) {
+    out.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (generate(rng, out[i]) != FleetStatus::Ok) {
+            out.clear();
+            return 0;
+        }
+    }
+    return count;
+}
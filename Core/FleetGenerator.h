@@ -0,0 +1,95 @@
+#pragma once
+#include "BitBoard.h"
+#include "PlacementTable.h"
+#include "Rng.h"
+#include "Types.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+struct ShipPlacement {
+    std::uint8_t x, y, size;
+    bool vertical;
+};
+
+struct FleetLayout {
+    FixedVector<ShipPlacement, MAX_FLEET_SIZE> ships;
+    BitBoard cells;
+};
+
+// Undecided — обмежений пошук не встиг ні знайти розстановку, ні довести, що її немає.
+enum class FleetStatus { Ok, Infeasible, Undecided };
+
+// Генератор розстановок флоту. Розстановка обирається рівномірно серед усіх допустимих:
+// вибірка з відкиданням (кожен корабель — випадкове розміщення, конфлікт — почати заново),
+// а для щільних наборів, де вона майже не вдається, — відкидання з пропозицією з таблиці:
+// перші кораблі беруться разом із переліку їхніх допустимих розстановок, решта — як звичайно.
+// Таблицю будує конструктор, тож generate не виділяє пам'ять і не зависає посеред сесії.
+// Пошук із поверненням лише доводить, що флот вміщується, і розстановок не видає.
+// Якщо флот не вміщується (або в ньому більше MAX_FLEET_SIZE кораблів), повертається
+// FleetStatus::Infeasible.
+class FleetGenerator {
+public:
+    FleetGenerator(int gridSize, const ShipSet& fleet);
+
+    // Генератор для останньої пари (розмір поля, флот) у цьому потоці: пробна вибірка
+    // й таблиця розстановок будуються один раз, а не на кожне поле чи перевірку.
+    // Для щільного флоту таблиця займає десятки мілісекунд.
+    static FleetGenerator& shared(int gridSize, const ShipSet& fleet);
+
+    // Лише пробна вибірка й обмежений за часом (FEASIBILITY_TIME_MS) пошук, без таблиці:
+    // досить дешево, щоб викликати на кожне натискання в налаштуваннях.
+    static FleetStatus check(int gridSize, const ShipSet& fleet);
+
+    int getGridSize() const { return gridSize; }
+    const ShipSet& getFleet() const { return fleet; }
+
+    FleetStatus generate(Rng& rng, FleetLayout& out);
+
+    // Заповнює out до count розстановок; повертає їх кількість (0, якщо флот не вміщується).
+    size_t generateBulk(Rng& rng, size_t count, std::vector<FleetLayout>& out);
+
+    // Стан, з'ясований у конструкторі: Ok, якщо розстановка точно існує.
+    FleetStatus status() const { return feasibility; }
+    bool isFeasible() const { return feasibility == FleetStatus::Ok; }
+
+private:
+    enum Mode { Sampling, Table, Stopped };
+    typedef std::array<std::uint16_t, MAX_FLEET_SIZE> Picks;
+
+    // Пробна вибірка в конструкторі: менше PROBE_MIN_ACCEPTED вдалих спроб із PROBE_ATTEMPTS
+    // означає щільний флот, і для нього одразу будується таблиця.
+    static const int PROBE_ATTEMPTS = 1024;
+    static const int PROBE_MIN_ACCEPTED = 16;
+    // Запобіжник для флотів, щільніших за будь-яку таблицю в лімітах: після стількох спроб
+    // generate повертає Undecided замість нескінченного циклу.
+    static const long long TABLE_ATTEMPT_LIMIT = 1LL << 24;
+    // Межі пошуку, що доводить існування розстановки, коли пробна вибірка нічого не знайшла.
+    static const long long FEASIBILITY_NODE_LIMIT = 4000000;
+    static constexpr int FEASIBILITY_TIME_MS = 20;
+    static const long long ENUMERATION_NODE_LIMIT = 20000000;
+    static const size_t TABLE_LIMIT = 1 << 20;
+
+    struct SearchBudget;
+
+    FleetGenerator(int gridSize, const ShipSet& fleet, bool withTable);
+
+    bool sampleOnce(Rng& rng, Picks& picks) const;
+    int probeSampling() const;
+    FleetStatus proveFeasible() const;
+    bool searchFrom(size_t ship, int minIdx, const BitBoard& occupied, SearchBudget& budget) const;
+    void buildTable();
+    bool enumerateFrom(size_t ship, size_t depth, int minIdx, const BitBoard& occupied, Picks& picks, long long& nodes);
+    bool sampleFromTable(Rng& rng, Picks& picks) const;
+    void buildLayout(const std::uint16_t* picks, FleetLayout& out) const;
+
+    int gridSize;
+    ShipSet fleet;
+    ShipSet order;
+    FixedVector<const std::vector<PlacementEntry>*, MAX_FLEET_SIZE> candidates;
+    Mode mode = Sampling;
+    FleetStatus feasibility = FleetStatus::Ok;
+    // Розстановки перших tableDepth кораблів, по tableDepth індексів на запис.
+    std::vector<std::uint16_t> table;
+    size_t tableDepth = 0;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "BitBoard.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+const int MIN_GRID_SIZE = 6;
+
+// Розмір поля як параметр шаблону: межі циклів і кількість слів BitBoard стають
+// константами, тож компілятор розгортає операції над площинами повністю.
+template <int N>
+struct GridShape {
+    static_assert(N >= MIN_GRID_SIZE && N <= MAX_GRID_SIZE, "unsupported grid size");
+    static const int SIZE = N;
+    // Слова BitBoard, у яких лежать клітинки поля.
+    static const int WORDS = ((N - 1) * BIT_STRIDE + N - 1) / 64 + 1;
+
+    static BitBoard field() { return BitBoard::fieldMask(N); }
+};
+
+template <template <int> class Kernel, int... I>
+const typename Kernel<MIN_GRID_SIZE>::Fn* gridKernelTable(std::integer_sequence<int, I...>) {
+    static const typename Kernel<MIN_GRID_SIZE>::Fn table[] = { Kernel<MIN_GRID_SIZE + I>::run... };
+    return table;
+}
+
+// Ядро Kernel<N>::run для розміру поля, відомого лише під час виконання. Вибирається
+// один раз — коли розмір поля стає відомим, а не на кожному ході. Розмір має бути в
+// межах MIN_GRID_SIZE..MAX_GRID_SIZE: ядра беруть маску поля з GridShape<N>, тож ядро
+// іншого розміру стріляло б повз поле. Межі перевіряють меню налаштувань і --grid у sim;
+// інший розмір — помилка виклику, і на неї кидається std::out_of_range у будь-якій збірці.
+template <template <int> class Kernel>
+typename Kernel<MIN_GRID_SIZE>::Fn gridKernel(int gridSize) {
+    const int count = MAX_GRID_SIZE - MIN_GRID_SIZE + 1;
+    const typename Kernel<MIN_GRID_SIZE>::Fn* table = gridKernelTable<Kernel>(std::make_integer_sequence<int, count>());
+    if (gridSize < MIN_GRID_SIZE || gridSize > MAX_GRID_SIZE)
+        throw std::out_of_range("gridKernel: no kernel for grid size " + std::to_string(gridSize));
+    return table[gridSize - MIN_GRID_SIZE];
+}
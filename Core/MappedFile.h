@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Файл, відображений у пам'ять лише для читання (mmap / MapViewOfFile).
+// Порожній файл відкривається успішно, але data() для нього — nullptr.
+class MappedFile {
+public:
+    MappedFile() {}
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const std::uint8_t* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const std::uint8_t* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+};
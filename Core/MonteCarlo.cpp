@@ -0,0 +1,157 @@
+#include "MonteCarlo.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+bool MonteCarloSampler::sampleLayout(const Problem& pr, Rng& rng, BitBoard& layout) {
+    BitBoard occupied = pr.sunkShips;
+    BitBoard covered;
+
+    std::array<bool, MAX_FLEET_SIZE> used{};
+    int left = static_cast<int>(pr.remaining.size());
+
+    // Спершу кораблі через поранені клітинки, інакше майже всі вибірки відкидалися б.
+    while (left > 0) {
+        BitBoard open = pr.wounded & ~covered;
+        if (!open.any())
+            break;
+        int hx = -1, hy = -1;
+        open.forEach([&](int x, int y) { if (hx < 0) { hx = x; hy = y; } });
+
+        bool placed = false;
+        for (int attempt = 0; attempt < 32 && !placed; ++attempt) {
+            int k = static_cast<int>(rng.below(left));
+            int shipIdx = -1;
+            for (int i = 0; i < static_cast<int>(pr.remaining.size()); ++i)
+                if (!used[i] && k-- == 0) { shipIdx = i; break; }
+            int size = pr.remaining[shipIdx];
+            const auto& through = pr.table->covering(size, BitBoard::bitIndex(hx, hy));
+            if (through.empty())
+                continue;
+            const PlacementEntry& e = pr.table->all(size)[through[rng.below(static_cast<std::uint32_t>(through.size()))]];
+            if (!Board::fitsShip(occupied, pr.forbidden, e))
+                continue;
+            const BitBoard& mask = e.mask;
+            if ((mask & ~pr.wounded).count() == 0)
+                continue;
+            occupied |= mask;
+            covered |= mask & pr.wounded;
+            used[shipIdx] = true;
+            left--;
+            placed = true;
+        }
+        if (!placed)
+            return false;
+    }
+    if ((pr.wounded & ~covered).any())
+        return false;
+
+    for (int i = 0; i < static_cast<int>(pr.remaining.size()); ++i) {
+        if (used[i])
+            continue;
+        const auto& list = pr.table->all(pr.remaining[i]);
+        bool placed = false;
+        for (int attempt = 0; attempt < 64 && !placed; ++attempt) {
+            const PlacementEntry& e = list[rng.below(static_cast<std::uint32_t>(list.size()))];
+            if (!Board::fitsShip(occupied, pr.forbidden | pr.wounded, e))
+                continue;
+            occupied |= e.mask;
+            placed = true;
+        }
+        if (!placed)
+            return false;
+    }
+    layout = occupied & ~pr.sunkShips;
+    return true;
+}
+
+bool MonteCarloSampler::chooseMove(const Board& board, const ShipSet& fleet, int budgetMs, Rng& rng, Coord& move) {
+    Problem pr;
+    pr.gridSize = board.getSize();
+    pr.table = &PlacementTable::forGrid(pr.gridSize);
+    pr.forbidden = board.missCells();
+    pr.wounded = board.hitCells() & ~board.sunkCells();
+    pr.remaining = fleet;
+    for (const auto& ship : board.getShips()) {
+        if (!ship.isSunk())
+            continue;
+        for (const auto& p : ship.positions)
+            pr.sunkShips.set(p.x, p.y);
+        auto it = std::find(pr.remaining.begin(), pr.remaining.end(), ship.size);
+        if (it != pr.remaining.end())
+            pr.remaining.erase(it);
+    }
+    pr.remaining.erase(std::remove_if(pr.remaining.begin(), pr.remaining.end(),
+        [&](int size) { return size <= 0 || size > pr.gridSize; }), pr.remaining.end());
+    std::sort(pr.remaining.begin(), pr.remaining.end(), std::greater<int>());
+
+    BitBoard unshot = pr.table->field() & ~(board.missCells() | board.hitCells());
+
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Counts> counts(threads);
+    // Лічильники кожен потік веде в локальних змінних і записує сюди один раз наприкінці,
+    // щоб сусідні елементи не ганяли спільний рядок кешу між ядрами.
+    std::vector<long long> samples(threads, 0), accepted(threads, 0);
+    // Одне число з потоку ШІ на хід, тож потік ШІ не залежить від кількості ядер;
+    // потік t-го обчислювача — (Worker, t) від цього зерна.
+    const RngService workers(rng());
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(budgetMs);
+    auto worker = [&](int t) {
+        Rng local = workers.stream(RngStream::Worker, static_cast<std::uint64_t>(t));
+        Counts& c = counts[t];
+        c.fill(0);
+        BitBoard layout;
+        long long tried = 0, kept = 0;
+        for (;;) {
+            for (int i = 0; i < 64; ++i) {
+                tried++;
+                if (!sampleLayout(pr, local, layout))
+                    continue;
+                kept++;
+                (layout & unshot).forEach([&](int x, int y) { c[BitBoard::bitIndex(x, y)]++; });
+            }
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
+        }
+        samples[t] = tried;
+        accepted[t] = kept;
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool)
+        th.join();
+
+    last = MonteCarloStats();
+    last.threads = threads;
+    last.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Counts merged{};
+    for (int t = 0; t < threads; ++t) {
+        last.samples += samples[t];
+        last.accepted += accepted[t];
+        for (size_t i = 0; i < merged.size(); ++i)
+            merged[i] += counts[t][i];
+    }
+    total.samples += last.samples;
+    total.accepted += last.accepted;
+    total.seconds += last.seconds;
+    total.threads = threads;
+
+    if (last.accepted == 0)
+        return false;
+
+    long long best = -1;
+    unshot.forEach([&](int x, int y) {
+        long long v = merged[BitBoard::bitIndex(x, y)];
+        if (v > best) {
+            best = v;
+            move = Coord(x, y);
+        }
+    });
+    return best >= 0;
+}
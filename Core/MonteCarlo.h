@@ -0,0 +1,45 @@
+#pragma once
+#include "BitBoard.h"
+#include "Board.h"
+#include "Rng.h"
+#include "Types.h"
+#include <array>
+#include <vector>
+
+struct MonteCarloStats {
+    long long samples = 0;
+    long long accepted = 0;
+    double seconds = 0.0;
+    int threads = 0;
+
+    double samplesPerSecond() const { return seconds > 0.0 ? samples / seconds : 0.0; }
+};
+
+// ШІ рівня 4: у всіх ядрах генерує випадкові розстановки решти флоту, сумісні з історією
+// пострілів, доки не вичерпається бюджет часу, і стріляє в клітинку, де корабель
+// опинявся найчастіше.
+class MonteCarloSampler {
+public:
+    // Повертає false, якщо за відведений час не знайшлося жодної сумісної розстановки.
+    bool chooseMove(const Board& board, const ShipSet& fleet, int budgetMs, Rng& rng, Coord& move);
+
+    const MonteCarloStats& lastStats() const { return last; }
+    const MonteCarloStats& totalStats() const { return total; }
+
+private:
+    typedef std::array<long long, BIT_STRIDE * BIT_STRIDE> Counts;
+
+    struct Problem {
+        int gridSize;
+        const PlacementTable* table;
+        BitBoard sunkShips;
+        BitBoard forbidden;
+        BitBoard wounded;
+        ShipSet remaining;
+    };
+
+    static bool sampleLayout(const Problem& pr, Rng& rng, BitBoard& layout);
+
+    MonteCarloStats last;
+    MonteCarloStats total;
+};
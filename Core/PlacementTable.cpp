@@ -0,0 +1,46 @@
+#include "PlacementTable.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+PlacementTable::PlacementTable(int gridSize)
+    : gridSize(gridSize), fieldMask(BitBoard::fieldMask(gridSize)), bySize(gridSize + 1)
+{
+    for (int size = 1; size <= gridSize; ++size) {
+        SizeTable& t = bySize[size];
+        t.covering.resize(BIT_STRIDE * BIT_STRIDE);
+        for (int v = 0; v < (size == 1 ? 1 : 2); ++v) {
+            bool vertical = v == 1;
+            if (vertical)
+                t.verticalStart = static_cast<int>(t.entries.size());
+            for (int y = 0; y + (vertical ? size : 1) <= gridSize; ++y) {
+                for (int x = 0; x + (vertical ? 1 : size) <= gridSize; ++x) {
+                    PlacementEntry e;
+                    e.mask = BitBoard::shipMask(x, y, size, vertical);
+                    e.halo = e.mask.grown(fieldMask);
+                    e.x = static_cast<std::uint8_t>(x);
+                    e.y = static_cast<std::uint8_t>(y);
+                    e.vertical = vertical;
+                    auto idx = static_cast<std::uint16_t>(t.entries.size());
+                    for (int i = 0; i < size; ++i)
+                        t.covering[BitBoard::bitIndex(x + (vertical ? 0 : i), y + (vertical ? i : 0))].push_back(idx);
+                    t.entries.push_back(e);
+                }
+            }
+        }
+    }
+}
+
+const PlacementTable& PlacementTable::forGrid(int gridSize) {
+    if (gridSize < 1 || gridSize > MAX_GRID_SIZE)
+        throw std::out_of_range("PlacementTable: no table for grid size " + std::to_string(gridSize));
+    static std::array<std::unique_ptr<PlacementTable>, MAX_GRID_SIZE + 1> tables;
+    static std::once_flag built;
+    std::call_once(built, [] {
+        for (int n = 1; n <= MAX_GRID_SIZE; ++n)
+            tables[n].reset(new PlacementTable(n));
+    });
+    return *tables[gridSize];
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "BitBoard.h"
+#include <cstdint>
+#include <vector>
+
+// Найбільша кількість розміщень корабля одного розміру: горизонтальні й вертикальні на полі 15x15.
+const int MAX_PLACEMENTS = 2 * MAX_GRID_SIZE * MAX_GRID_SIZE;
+
+struct PlacementEntry {
+    BitBoard mask;
+    BitBoard halo;      // mask разом із сусідніми клітинками, у які не можна ставити інші кораблі
+    std::uint8_t x, y;
+    bool vertical;
+};
+
+// Усі допустимі розміщення одного корабля на порожньому полі заданого розміру.
+// Таблиці будуються один раз на розмір поля і спільні для перевірки розміщення,
+// генератора флоту та ШІ.
+class PlacementTable {
+public:
+    // Розмір поза 1..MAX_GRID_SIZE кидає std::out_of_range.
+    static const PlacementTable& forGrid(int gridSize);
+
+    int getGridSize() const { return gridSize; }
+    const BitBoard& field() const { return fieldMask; }
+
+    // Спершу горизонтальні, потім вертикальні; для size == 1 — лише горизонтальні.
+    const std::vector<PlacementEntry>& all(int size) const { return bySize[size].entries; }
+
+    // Індекси в all(size) розміщень, що накривають клітинку bitIndex.
+    const std::vector<std::uint16_t>& covering(int size, int bitIndex) const { return bySize[size].covering[bitIndex]; }
+
+    // nullptr, якщо корабель виходить за межі поля.
+    const PlacementEntry* at(int x, int y, int size, bool vertical) const {
+        if (size <= 0 || size > gridSize || x < 0 || y < 0)
+            return nullptr;
+        if (size == 1)
+            vertical = false;
+        int spanX = vertical ? 1 : size, spanY = vertical ? size : 1;
+        if (x + spanX > gridSize || y + spanY > gridSize)
+            return nullptr;
+        const SizeTable& t = bySize[size];
+        int idx = vertical ? t.verticalStart + y * gridSize + x : y * (gridSize - size + 1) + x;
+        return &t.entries[idx];
+    }
+
+private:
+    explicit PlacementTable(int gridSize);
+
+    struct SizeTable {
+        int verticalStart = 0;
+        std::vector<PlacementEntry> entries;
+        std::vector<std::vector<std::uint16_t>> covering;
+    };
+
+    int gridSize;
+    BitBoard fieldMask;
+    std::vector<SizeTable> bySize;
+};
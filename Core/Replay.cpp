@@ -0,0 +1,210 @@
+#include "Replay.h"
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'B', 'R', 'P' };
+const std::size_t HEADER_SIZE = 16;
+
+std::uint8_t packCell(const Coord& c) {
+    return static_cast<std::uint8_t>(c.y << 4 | c.x);
+}
+
+Coord unpackCell(std::uint8_t b) {
+    return Coord(b & 15, b >> 4);
+}
+
+}
+
+bool ReplayWriter::open(const std::string& path, const ReplayHeader& header) {
+    close();
+    // У заголовку один лічильник кораблів на обидва флоти, і читач приймає не більше MAX_FLEET_SIZE.
+    std::size_t shipCount = header.fleets[0].size();
+    if (header.fleets[1].size() != shipCount || shipCount > static_cast<std::size_t>(MAX_FLEET_SIZE))
+        return false;
+    out = std::fopen(path.c_str(), "wb");
+    if (!out)
+        return false;
+    std::vector<std::uint8_t> bytes(MAGIC, MAGIC + 4);
+    bytes.push_back(static_cast<std::uint8_t>(REPLAY_VERSION));
+    bytes.push_back(static_cast<std::uint8_t>(header.gridSize));
+    bytes.push_back(static_cast<std::uint8_t>(header.aiLevel));
+    bytes.push_back(static_cast<std::uint8_t>(shipCount));
+    for (int i = 0; i < 8; ++i)
+        bytes.push_back(static_cast<std::uint8_t>(header.seed >> (8 * i)));
+    for (const auto& fleet : header.fleets) {
+        for (const auto& p : fleet) {
+            bytes.push_back(packCell(Coord(p.x, p.y)));
+            bytes.push_back(static_cast<std::uint8_t>(p.size | (p.vertical ? 0x80 : 0)));
+        }
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size() && std::fflush(out) == 0;
+    if (!ok)
+        close();
+    return ok;
+}
+
+void ReplayWriter::shot(const ReplayShot& s) {
+    if (!out)
+        return;
+    std::uint8_t record[2] = {
+        packCell(s.cell),
+        static_cast<std::uint8_t>((s.shooter ? ReplayShot::ByAI : 0) | (s.hit ? ReplayShot::Hit : 0) |
+                                  (s.sunk ? ReplayShot::Sunk : 0) | (s.gameOver ? ReplayShot::GameOver : 0))
+    };
+    std::fwrite(record, 1, 2, out);
+    std::fflush(out);
+}
+
+void ReplayWriter::close() {
+    if (out)
+        std::fclose(out);
+    out = nullptr;
+}
+
+std::string ReplayWriter::archivePath(const std::string& dir) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof stamp, "%Y%m%d-%H%M%S", std::localtime(&now));
+    std::string base = (std::filesystem::path(dir) / stamp).string();
+    std::string path = base + ".sbr";
+    for (int n = 2; std::filesystem::exists(path, ec); ++n)
+        path = base + "-" + std::to_string(n) + ".sbr";
+    return path;
+}
+
+std::vector<ShipPlacement> ReplayWriter::fleetOf(const Board& board) {
+    std::vector<ShipPlacement> fleet;
+    for (const auto& ship : board.getShips()) {
+        const Coord& first = ship.positions.front();
+        bool vertical = ship.positions.size() > 1 && ship.positions[1].x == first.x;
+        fleet.push_back(ShipPlacement{ static_cast<std::uint8_t>(first.x), static_cast<std::uint8_t>(first.y),
+                                       static_cast<std::uint8_t>(ship.size), vertical });
+    }
+    return fleet;
+}
+
+bool ReplayReader::fail(const std::string& what) {
+    message = what;
+    file.close();
+    shotData = nullptr;
+    shotCount = 0;
+    snapshots.clear();
+    return false;
+}
+
+bool ReplayReader::open(const std::string& path) {
+    message.clear();
+    if (!file.open(path))
+        return fail("cannot open " + path);
+    const std::uint8_t* data = file.data();
+    std::size_t size = file.size();
+    if (size < HEADER_SIZE || !std::equal(MAGIC, MAGIC + 4, data))
+        return fail("not a replay file");
+    if (data[4] != REPLAY_VERSION)
+        return fail("unsupported replay version " + std::to_string(data[4]));
+
+    head = ReplayHeader();
+    head.gridSize = data[5];
+    head.aiLevel = data[6];
+    int shipCount = data[7];
+    head.seed = 0;
+    for (int i = 0; i < 8; ++i)
+        head.seed |= static_cast<std::uint64_t>(data[8 + i]) << (8 * i);
+    if (head.gridSize < 1 || head.gridSize > MAX_GRID_SIZE)
+        return fail("bad grid size");
+    // Номер корабля зберігається в Fleet::shipAt як int8_t.
+    if (shipCount > MAX_FLEET_SIZE)
+        return fail("too many ships");
+    std::size_t fleetEnd = HEADER_SIZE + 4 * static_cast<std::size_t>(shipCount);
+    if (size < fleetEnd)
+        return fail("truncated fleet");
+
+    const BitBoard field = BitBoard::fieldMask(head.gridSize);
+    const std::uint8_t* p = data + HEADER_SIZE;
+    for (int f = 0; f < 2; ++f) {
+        Fleet& fleet = fleets[f];
+        fleet.cells.clear();
+        fleet.ships.clear();
+        fleet.shipAt.fill(-1);
+        for (int i = 0; i < shipCount; ++i, p += 2) {
+            Coord at = unpackCell(p[0]);
+            ShipPlacement sp{ static_cast<std::uint8_t>(at.x), static_cast<std::uint8_t>(at.y),
+                              static_cast<std::uint8_t>(p[1] & 0x7F), (p[1] & 0x80) != 0 };
+            int endX = sp.x + (sp.vertical ? 1 : sp.size), endY = sp.y + (sp.vertical ? sp.size : 1);
+            if (sp.size == 0 || endX > head.gridSize || endY > head.gridSize)
+                return fail("ship outside the grid");
+            BitBoard mask = BitBoard::shipMask(sp.x, sp.y, sp.size, sp.vertical);
+            if (mask.intersects(fleet.cells))
+                return fail("overlapping ships");
+            if (mask.grown(field).intersects(fleet.cells))
+                return fail("touching ships");
+            mask.forEach([&](int x, int y) { fleet.shipAt[BitBoard::bitIndex(x, y)] = static_cast<std::int8_t>(i); });
+            fleet.cells |= mask;
+            fleet.ships.push_back(mask);
+            head.fleets[f].push_back(sp);
+        }
+    }
+
+    // Обірваний останній запис і постріли поза полем відкидаються: читаємо до них.
+    shotData = data + fleetEnd;
+    shotCount = static_cast<int>((size - fleetEnd) / 2);
+    for (int t = 0; t < shotCount; ++t) {
+        Coord c = unpackCell(shotData[2 * t]);
+        if (c.x >= head.gridSize || c.y >= head.gridSize) {
+            message = "invalid shot at turn " + std::to_string(t) + ", replay truncated";
+            shotCount = t;
+            break;
+        }
+    }
+
+    snapshots.assign(1, ReplayPosition());
+    ReplayPosition pos;
+    for (int t = 0; t < shotCount; ++t) {
+        apply(pos, t);
+        if ((t + 1) % SNAPSHOT_INTERVAL == 0)
+            snapshots.push_back(pos);
+    }
+    return true;
+}
+
+ReplayShot ReplayReader::shot(int turn) const {
+    ReplayShot s;
+    std::uint8_t flags = shotData[2 * turn + 1];
+    s.cell = unpackCell(shotData[2 * turn]);
+    s.shooter = (flags & ReplayShot::ByAI) ? 1 : 0;
+    s.hit = (flags & ReplayShot::Hit) != 0;
+    s.sunk = (flags & ReplayShot::Sunk) != 0;
+    s.gameOver = (flags & ReplayShot::GameOver) != 0;
+    return s;
+}
+
+// Влучання і потоплення рахуються з флотів, а не з прапорців запису.
+void ReplayReader::apply(ReplayPosition& pos, int turn) const {
+    ReplayShot s = shot(turn);
+    int target = 1 - s.shooter;
+    const Fleet& fleet = fleets[target];
+    if (!fleet.cells.test(s.cell.x, s.cell.y)) {
+        pos.miss[target].set(s.cell.x, s.cell.y);
+        return;
+    }
+    pos.hit[target].set(s.cell.x, s.cell.y);
+    const BitBoard& ship = fleet.ships[fleet.shipAt[BitBoard::bitIndex(s.cell.x, s.cell.y)]];
+    if ((ship & ~pos.hit[target]) == BitBoard())
+        pos.sunk[target] |= ship;
+}
+
+ReplayPosition ReplayReader::positionAt(int turn) const {
+    if (snapshots.empty())
+        return ReplayPosition();
+    if (turn < 0) turn = 0;
+    if (turn > shotCount) turn = shotCount;
+    ReplayPosition pos = snapshots[turn / SNAPSHOT_INTERVAL];
+    for (int t = turn / SNAPSHOT_INTERVAL * SNAPSHOT_INTERVAL; t < turn; ++t)
+        apply(pos, t);
+    return pos;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "BitBoard.h"
+#include "Board.h"
+#include "FleetGenerator.h"
+#include "MappedFile.h"
+#include "Types.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Двійковий запис партії (.sbr). Багатобайтові числа — little-endian.
+//   "SBRP", версія, розмір поля, рівень ШІ, кількість кораблів n     8 байт
+//   зерно партії для RngService (0 — невідоме)                       8 байт
+//   флот гравця 0, потім флот гравця 1: по 2 байти на корабель
+//     (y << 4 | x, розмір | вертикальний << 7)
+//   постріли до кінця файлу: по 2 байти
+//     (y << 4 | x, прапорці ReplayShot::Flags)
+// Гравець 0 — людина, 1 — ШІ; постріл гравця p іде по флоту 1 - p.
+const int REPLAY_VERSION = 1;
+
+struct ReplayShot {
+    enum Flags { ByAI = 1, Hit = 2, Sunk = 4, GameOver = 8 };
+
+    Coord cell;
+    int shooter = 0;
+    bool hit = false;
+    bool sunk = false;
+    bool gameOver = false;
+};
+
+struct ReplayHeader {
+    int gridSize = 10;
+    int aiLevel = 1;
+    std::uint64_t seed = 0;
+    std::vector<ShipPlacement> fleets[2];
+};
+
+// Стан обох полів після певної кількості пострілів; індекс — власник флоту.
+struct ReplayPosition {
+    BitBoard miss[2], hit[2], sunk[2];
+};
+
+class ReplayWriter {
+public:
+    ReplayWriter() {}
+    ~ReplayWriter() { close(); }
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    bool open(const std::string& path, const ReplayHeader& header);
+    // Постріл одразу потрапляє у файл, тож обірваний запис читається до останнього ходу.
+    void shot(const ReplayShot& s);
+    void close();
+    bool isOpen() const { return out != nullptr; }
+
+    // Новий файл у каталозі dir з датою й часом у назві; каталог створюється за потреби.
+    static std::string archivePath(const std::string& dir);
+    static std::vector<ShipPlacement> fleetOf(const Board& board);
+
+private:
+    std::FILE* out = nullptr;
+};
+
+// Читає запис через відображення файлу в пам'ять. При відкритті один раз програє
+// всі постріли і зберігає знімок стану кожні SNAPSHOT_INTERVAL ходів, тож перехід
+// до будь-якого ходу — це знімок плюс менше SNAPSHOT_INTERVAL пострілів.
+class ReplayReader {
+public:
+    static const int SNAPSHOT_INTERVAL = 32;
+
+    bool open(const std::string& path);
+    const std::string& error() const { return message; }
+
+    const ReplayHeader& header() const { return head; }
+    int turns() const { return shotCount; }
+    ReplayShot shot(int turn) const;
+    // Стан після перших turn пострілів.
+    ReplayPosition positionAt(int turn) const;
+    const BitBoard& shipCells(int player) const { return fleets[player].cells; }
+
+private:
+    struct Fleet {
+        BitBoard cells;
+        std::vector<BitBoard> ships;
+        std::array<std::int8_t, BIT_STRIDE * BIT_STRIDE> shipAt;
+    };
+
+    bool fail(const std::string& what);
+    void apply(ReplayPosition& pos, int turn) const;
+
+    MappedFile file;
+    const std::uint8_t* shotData = nullptr;
+    int shotCount = 0;
+    ReplayHeader head;
+    Fleet fleets[2];
+    std::vector<ReplayPosition> snapshots;
+    std::string message;
+};
@@ -0,0 +1,10 @@
+#include "Rng.h"
+#include <chrono>
+#include <random>
+
+std::uint64_t RngService::freshSeed() {
+    std::random_device device;
+    std::uint64_t entropy = (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    std::uint64_t now = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    return Rng::mix(entropy ^ Rng::mix(now));
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+
+// Лічильниковий генератор: i-те число потоку — mix(key + i * GAMMA), де mix — фіналізатор
+// SplitMix64. Стан — 16 байтів (ключ і лічильник) замість 5 КБ у mt19937, перехід на будь-яку
+// позицію — O(1). Різні ключі дають незалежні потоки, тож кожна партія, поле й потік
+// обчислень отримують власний, і результат не залежить від того, хто першим його попросить.
+// Задовольняє вимоги UniformRandomBitGenerator, але для відтворюваності між компіляторами
+// ядро бере числа через below, а не через std::uniform_int_distribution.
+class Rng {
+public:
+    typedef std::uint64_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    Rng() {}
+    explicit Rng(std::uint64_t key) : key(key) {}
+
+    result_type operator()() { return mix(key + ++counter * GAMMA); }
+
+    // Рівномірне число з [0, n), n > 0: множення зі зсувом (Лемір) замість ділення.
+    std::uint32_t below(std::uint32_t n) {
+        std::uint64_t m = ((*this)() >> 32) * n;
+        if (static_cast<std::uint32_t>(m) < n) {
+            std::uint32_t threshold = (0u - n) % n;
+            while (static_cast<std::uint32_t>(m) < threshold)
+                m = ((*this)() >> 32) * n;
+        }
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+    // Рівномірне число з [0, 1).
+    float uniform() { return ((*this)() >> 40) * (1.0f / 16777216.0f); }
+
+    void discard(std::uint64_t n) { counter += n; }
+    std::uint64_t position() const { return counter; }
+
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static const std::uint64_t GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t key = 0;
+    std::uint64_t counter = 0;
+};
+
+enum class RngStream : std::uint32_t { Game, Board, AI, Worker, Effects };
+
+// Джерело всіх випадкових потоків гри чи симуляції. Одне 64-бітне зерно визначає
+// потік кожного виду й номера, а game(n) — зерно n-ї партії, тож будь-яку партію
+// (зокрема з паралельного прогону) можна відтворити окремо від решти.
+class RngService {
+public:
+    explicit RngService(std::uint64_t seed = 0) : rootSeed(seed) {}
+
+    std::uint64_t seed() const { return rootSeed; }
+
+    Rng stream(RngStream kind, std::uint64_t index = 0) const {
+        std::uint64_t base = Rng::mix(rootSeed + (static_cast<std::uint64_t>(kind) + 1) * 0xD1B54A32D192ED03ULL);
+        return Rng(Rng::mix(base ^ Rng::mix(index + 0x8CB92BA72F3D8DD7ULL)));
+    }
+
+    RngService game(std::uint64_t number) const {
+        return RngService(stream(RngStream::Game, number)());
+    }
+
+    // Зерно для запусків без явного --seed: random_device змішаний із годинником.
+    static std::uint64_t freshSeed();
+
+private:
+    std::uint64_t rootSeed;
+};
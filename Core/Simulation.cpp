@@ -0,0 +1,17 @@
+#include "Simulation.h"
+
+int playOut(const Settings& settings, AI& ai, int aiLevel, const RngService& game) {
+    Rng placement = game.stream(RngStream::Board);
+    Board target(true, settings);
+    if (!target.placeAllShips(placement))
+        return -1;
+    ai.reset();
+    ai.setRng(game.stream(RngStream::AI));
+    int shots = 0;
+    int limit = settings.gridSize * settings.gridSize * 4;
+    while (!target.allSunk() && shots < limit) {
+        target.receiveShot(ai.getMove(target, aiLevel));
+        shots++;
+    }
+    return shots;
+}
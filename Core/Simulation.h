@@ -0,0 +1,9 @@
+#pragma once
+#include "AI.h"
+#include "Board.h"
+#include "Types.h"
+
+// Партія без вікна: ШІ стріляє по випадково розставленому флоту, доки не потопить усі кораблі.
+// Розстановка й ходи ШІ беруться з потоків game. Повертає кількість пострілів
+// або -1, якщо флот не вдалося розставити.
+int playOut(const Settings& settings, AI& ai, int aiLevel, const RngService& game);
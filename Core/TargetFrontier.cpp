@@ -0,0 +1,119 @@
+#include "TargetFrontier.h"
+
+template <int N>
+struct TargetFrontier::SyncKernel {
+    typedef SyncFn Fn;
+    static void run(TargetFrontier& frontier, const Board& board) { frontier.syncFixed<N>(board); }
+};
+
+template <int N>
+struct TargetFrontier::PickKernel {
+    typedef PickFn Fn;
+    static Coord run(const TargetFrontier& frontier, Rng& rng) { return frontier.pickFixed<N>(rng); }
+};
+
+void TargetFrontier::reset(int newGridSize) {
+    gridSize = newGridSize;
+    syncKernel = gridKernel<SyncKernel>(gridSize);
+    pickKernel = gridKernel<PickKernel>(gridSize);
+    field = BitBoard::fieldMask(gridSize);
+    open = field;
+    wounded.clear();
+    targets.clear();
+    seenMiss.clear();
+    seenHit.clear();
+    seenSunk.clear();
+    lattice.clear();
+    latticeSpacing = 0;
+}
+
+void TargetFrontier::sync(const Board& board) {
+    if (board.getSize() != gridSize)
+        reset(board.getSize());
+    syncKernel(*this, board);
+}
+
+template <int N>
+void TargetFrontier::syncFixed(const Board& board) {
+    const int W = GridShape<N>::WORDS;
+    if ((seenMiss & ~board.missCells()).any<W>() || (seenHit & ~board.hitCells()).any<W>())
+        reset(gridSize);
+
+    BitBoard newMiss = board.missCells() & ~seenMiss;
+    BitBoard newHit = board.hitCells() & ~seenHit;
+    BitBoard newSunk = board.sunkCells() & ~seenSunk;
+    seenMiss = board.missCells();
+    seenHit = board.hitCells();
+    seenSunk = board.sunkCells();
+    if (!(newMiss | newHit).any<W>()) {
+        if (latticeSpacing == 0)
+            updateLattice<N>(board.smallestAfloat());
+        return;
+    }
+
+    // Кораблі не торкаються: діагональні сусіди влучання і весь ореол
+    // потопленого корабля гарантовано порожні.
+    BitBoard side = newHit.shl<W>(1) | newHit.shr<W>(1);
+    BitBoard blocked = newMiss | newHit | side.shl<W>(BIT_STRIDE) | side.shr<W>(BIT_STRIDE);
+    bool sunk = newSunk.any<W>();
+    if (sunk)
+        blocked |= newSunk.grown<W>(field);
+    open &= ~blocked;
+    if (latticeSpacing == 0 || sunk)
+        updateLattice<N>(board.smallestAfloat());
+
+    wounded = (wounded | newHit) & ~seenSunk;
+    updateTargets<N>();
+}
+
+// Влучання з сусідом по горизонталі чи вертикалі задають орієнтацію корабля —
+// продовжуємо лише цю лінію. Одиночне влучання дає чотирьох сусідів.
+template <int N>
+void TargetFrontier::updateTargets() {
+    const int W = GridShape<N>::WORDS;
+    BitBoard rowHits = wounded & (wounded.shl<W>(1) | wounded.shr<W>(1));
+    BitBoard columnHits = wounded & (wounded.shl<W>(BIT_STRIDE) | wounded.shr<W>(BIT_STRIDE));
+    BitBoard single = wounded & ~rowHits & ~columnHits;
+    BitBoard across = rowHits | single;
+    BitBoard along = columnHits | single;
+    targets = (across.shl<W>(1) | across.shr<W>(1) | along.shl<W>(BIT_STRIDE) | along.shr<W>(BIT_STRIDE)) & open;
+}
+
+// Решітка перебудовується лише тоді, коли змінився найменший корабель на плаву.
+// Із можливих зсувів береться той, де лишилося найменше відкритих клітинок.
+template <int N>
+void TargetFrontier::updateLattice(int spacing) {
+    const int W = GridShape<N>::WORDS;
+    spacing = spacing < 1 ? 1 : spacing;
+    if (spacing == latticeSpacing)
+        return;
+    latticeSpacing = spacing;
+
+    BitBoard byResidue[MAX_GRID_SIZE];
+    field.forEach([&](int x, int y) { byResidue[(x + y) % spacing].set(x, y); });
+    int best = 0, bestCount = (byResidue[0] & open).count<W>();
+    for (int r = 1; r < spacing; ++r) {
+        int count = (byResidue[r] & open).count<W>();
+        if (count < bestCount) {
+            best = r;
+            bestCount = count;
+        }
+    }
+    lattice = byResidue[best];
+}
+
+template <int N>
+Coord TargetFrontier::pickFixed(Rng& rng) const {
+    const int W = GridShape<N>::WORDS;
+    BitBoard pool = targets;
+    if (!pool.any<W>())
+        pool = lattice & open;
+    if (!pool.any<W>())
+        pool = open;
+    if (!pool.any<W>())
+        pool = field & ~(seenMiss | seenHit);
+    if (!pool.any<W>())
+        return Coord(0, 0);
+    int i = pool.nthIndex<W>(static_cast<int>(rng.below(pool.count<W>())));
+    return Coord(i % BIT_STRIDE, i / BIT_STRIDE);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "BitBoard.h"
+#include "Board.h"
+#include "GridShape.h"
+#include "Rng.h"
+#include "Types.h"
+
+// Стан ШІ рівня 2. Цілі — бітова маска, тож клітинка не потрапляє в неї двічі.
+// Оновлюється з різниці площин поля: після двох влучань в одну лінію ціляться лише
+// кінці цієї лінії, а ореол навколо потопленого корабля виключається з пошуку.
+// Пошук іде діагональною решіткою з кроком у найменший непотоплений корабель.
+// Обробка спеціалізована під розмір поля; ядро вибирається в reset().
+class TargetFrontier {
+public:
+    void reset(int gridSize);
+
+    // Враховує постріли, зроблені по полю після попереднього виклику.
+    void sync(const Board& board);
+
+    // Випадкова ціль біля пораненого корабля, а якщо такого немає — клітинка пошуку.
+    Coord pick(Rng& rng) const { return pickKernel(*this, rng); }
+
+    const BitBoard& targetCells() const { return targets; }
+
+private:
+    typedef void (*SyncFn)(TargetFrontier&, const Board&);
+    typedef Coord (*PickFn)(const TargetFrontier&, Rng&);
+    template <int N> struct SyncKernel;
+    template <int N> struct PickKernel;
+
+    template <int N> void syncFixed(const Board& board);
+    template <int N> Coord pickFixed(Rng& rng) const;
+    template <int N> void updateTargets();
+    template <int N> void updateLattice(int spacing);
+
+    SyncFn syncKernel = nullptr;
+    PickFn pickKernel = nullptr;
+    int gridSize = 0;
+    BitBoard field;
+    // Необстріляні клітинки, де ще може стояти корабель.
+    BitBoard open;
+    BitBoard wounded;
+    BitBoard targets;
+    // Клітинки (x + y) % latticeSpacing == залишок; кожне розміщення корабля
+    // завдовжки не менше latticeSpacing накриває щонайменше одну з них.
+    BitBoard lattice;
+    int latticeSpacing = 0;
+    BitBoard seenMiss, seenHit, seenSunk;
+};
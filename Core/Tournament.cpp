@@ -0,0 +1,128 @@
+#include "Tournament.h"
+#include "Board.h"
+#include "WorkStealingScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+void MatchStats::merge(const MatchStats& o) {
+    games += o.games;
+    winsA += o.winsA;
+    winsB += o.winsB;
+    if (shotsToWinA.size() < o.shotsToWinA.size()) shotsToWinA.resize(o.shotsToWinA.size());
+    if (shotsToWinB.size() < o.shotsToWinB.size()) shotsToWinB.resize(o.shotsToWinB.size());
+    for (size_t i = 0; i < o.shotsToWinA.size(); ++i) shotsToWinA[i] += o.shotsToWinA[i];
+    for (size_t i = 0; i < o.shotsToWinB.size(); ++i) shotsToWinB[i] += o.shotsToWinB[i];
+}
+
+int playMatch(const Settings& settings, AI& first, int firstLevel, AI& second, int secondLevel, const RngService& game, int& shots) {
+    Rng placement[2] = { game.stream(RngStream::Board, 0), game.stream(RngStream::Board, 1) };
+    Board boards[2] = { Board(true, settings), Board(true, settings) };
+    if (!boards[0].placeAllShips(placement[0]) || !boards[1].placeAllShips(placement[1]))
+        return -1;
+    AI* players[2] = { &first, &second };
+    int levels[2] = { firstLevel, secondLevel };
+    int fired[2] = { 0, 0 };
+    first.reset(settings);
+    second.reset(settings);
+    first.setRng(game.stream(RngStream::AI, 0));
+    second.setRng(game.stream(RngStream::AI, 1));
+
+    // boards[p] — флот гравця p, по ньому стріляє суперник.
+    int limit = settings.gridSize * settings.gridSize * 4;
+    int turn = 0;
+    while (fired[0] + fired[1] < limit) {
+        Board& target = boards[1 - turn];
+        bool hit = target.receiveShot(players[turn]->getMove(target, levels[turn]));
+        fired[turn]++;
+        if (target.allSunk()) {
+            shots = fired[turn];
+            return turn;
+        }
+        if (!hit)
+            turn = 1 - turn;
+    }
+    shots = fired[turn];
+    return turn;
+}
+
+TournamentResult runTournament(const TournamentOptions& options) {
+    TournamentResult result;
+    result.fleet = FleetGenerator::shared(options.settings.gridSize, options.settings.shipSet).status();
+    if (result.fleet != FleetStatus::Ok)
+        return result;
+
+    std::vector<std::pair<int, int>> pairs;
+    for (size_t i = 0; i < options.levels.size(); ++i)
+        for (size_t j = i + 1; j < options.levels.size(); ++j)
+            pairs.emplace_back(options.levels[i], options.levels[j]);
+    if (pairs.empty() && options.levels.size() == 1)
+        pairs.emplace_back(options.levels[0], options.levels[0]);
+
+    int threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    int histSize = options.settings.gridSize * options.settings.gridSize * 4 + 1;
+
+    struct Worker {
+        std::vector<std::unique_ptr<AI>> first, second;
+        std::vector<MatchStats> stats;
+    };
+    std::vector<Worker> workers(threads);
+    for (int t = 0; t < threads; ++t) {
+        Worker& w = workers[t];
+        for (size_t p = 0; p < pairs.size(); ++p) {
+            w.first.emplace_back(new AI(options.settings));
+            w.second.emplace_back(new AI(options.settings));
+            MatchStats s;
+            s.levelA = pairs[p].first;
+            s.levelB = pairs[p].second;
+            s.shotsToWinA.assign(histSize, 0);
+            s.shotsToWinB.assign(histSize, 0);
+            w.stats.push_back(s);
+        }
+    }
+
+    RngService root(options.seed);
+    std::atomic<bool> unplaced(false);
+    long long total = options.gamesPerPair * static_cast<long long>(pairs.size());
+    auto start = std::chrono::steady_clock::now();
+    WorkStealingScheduler::run(total, threads, 64, [&](int self, long long begin, long long end) {
+        Worker& w = workers[self];
+        for (long long g = begin; g < end; ++g) {
+            size_t p = static_cast<size_t>(g / options.gamesPerPair);
+            MatchStats& s = w.stats[p];
+            AI& a = *w.first[p];
+            AI& b = *w.second[p];
+            bool aStarts = (g % 2) == 0;
+            int shots = 0;
+            int winner = aStarts
+                ? playMatch(options.settings, a, s.levelA, b, s.levelB, root.game(g), shots)
+                : playMatch(options.settings, b, s.levelB, a, s.levelA, root.game(g), shots);
+            if (winner < 0) {
+                unplaced = true;
+                continue;
+            }
+            if (!aStarts)
+                winner = 1 - winner;
+            s.games++;
+            if (winner == 0) { s.winsA++; s.shotsToWinA[shots]++; }
+            else             { s.winsB++; s.shotsToWinB[shots]++; }
+        }
+    });
+
+    // Генератор у потоці-виконавці здався (FleetStatus::Undecided) — неповну статистику не віддаємо.
+    if (unplaced) {
+        result.fleet = FleetStatus::Undecided;
+        return result;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.games = total;
+    for (size_t p = 0; p < pairs.size(); ++p) {
+        MatchStats merged = workers[0].stats[p];
+        for (int t = 1; t < threads; ++t)
+            merged.merge(workers[t].stats[p]);
+        result.matches.push_back(merged);
+    }
+    return result;
+}
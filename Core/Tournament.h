@@ -0,0 +1,49 @@
+#pragma once
+#include "AI.h"
+#include "FleetGenerator.h"
+#include "Rng.h"
+#include "Types.h"
+#include <cstdint>
+#include <vector>
+
+struct MatchStats {
+    int levelA = 0;
+    int levelB = 0;
+    long long games = 0;
+    long long winsA = 0;
+    long long winsB = 0;
+    // Гістограми: індекс — кількість пострілів переможця.
+    std::vector<long long> shotsToWinA;
+    std::vector<long long> shotsToWinB;
+
+    void merge(const MatchStats& o);
+};
+
+struct TournamentOptions {
+    Settings settings;
+    std::vector<int> levels = { 1, 2, 3 };
+    long long gamesPerPair = 10000;
+    int threads = 0;                // 0 — усі ядра
+    std::uint64_t seed = 1;
+};
+
+struct TournamentResult {
+    // Не Ok — флот не вміщується на полі (або це не вдалося з'ясувати), партії не грались.
+    FleetStatus fleet = FleetStatus::Ok;
+    std::vector<MatchStats> matches;
+    long long games = 0;
+    double seconds = 0.0;
+
+    double gamesPerSecond() const { return seconds > 0.0 ? games / seconds : 0.0; }
+};
+
+// Одна партія ШІ проти ШІ за правилами гри: після влучання стріляє той самий гравець.
+// Повертає 0, якщо переміг first, і 1, якщо second; shots — пострілів переможця;
+// -1 — флот не вдалося розставити.
+// Розстановки й ходи ШІ беруться лише з потоків game, тож партія відтворюється за game.seed().
+int playMatch(const Settings& settings, AI& first, int firstLevel, AI& second, int secondLevel, const RngService& game, int& shots);
+
+// Кругова система: кожна пара рівнів грає gamesPerPair партій, по черзі починаючи першою.
+// Партія g грає з RngService(seed).game(g), тож результат не залежить від кількості потоків.
+// Якщо флот налаштувань не розставляється, турнір не починається, а result.fleet це повідомляє.
+TournamentResult runTournament(const TournamentOptions& options);
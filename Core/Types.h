@@ -0,0 +1,42 @@
+#pragma once
+#include "BitBoard.h"
+#include "FixedVector.h"
+
+// Найбільший флот; стільки ж кораблів розрізняє BoardBatch і вибірка MonteCarloSampler.
+const int MAX_FLEET_SIZE = 32;
+
+// Координата клітинки поля: x — стовпчик, y — рядок.
+struct Coord {
+    int x = 0;
+    int y = 0;
+
+    Coord() {}
+    Coord(int x, int y) : x(x), y(y) {}
+
+    bool operator==(const Coord& o) const { return x == o.x && y == o.y; }
+    bool operator!=(const Coord& o) const { return !(*this == o); }
+};
+
+enum CellState { Empty, ShipCell, Miss, Hit };
+
+struct Ship {
+    int size;
+    FixedVector<Coord, MAX_GRID_SIZE> positions;
+    int hits = 0;
+    bool sunk = false;
+    bool isSunk() const { return sunk; }
+};
+
+typedef FixedVector<int, MAX_FLEET_SIZE> ShipSet;
+typedef FixedVector<Ship, MAX_FLEET_SIZE> ShipList;
+
+struct Settings {
+    int aiLevel = 1;
+    int gridSize = 10;
+    ShipSet shipSet = { 5,4,3,3,2 };
+    int aiTimeBudgetMs = 50;
+    // Пауза між показом пострілів ШІ в грі.
+    int aiShotDelayMs = 300;
+    int themeIdx = 0; 
+    bool showHints = false; 
+};
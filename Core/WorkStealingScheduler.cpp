@@ -0,0 +1,92 @@
+#include "WorkStealingScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Range {
+    long long begin, end;
+};
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Range> ranges;
+
+    void push(const Range& r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ranges.push_back(r);
+    }
+
+    bool popBack(Range& r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ranges.empty()) return false;
+        r = ranges.back();
+        ranges.pop_back();
+        return true;
+    }
+
+    bool stealFront(Range& r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ranges.empty()) return false;
+        r = ranges.front();
+        ranges.pop_front();
+        return true;
+    }
+};
+
+}
+
+void WorkStealingScheduler::run(long long count, int threads, long long grain, const Body& body) {
+    if (count <= 0)
+        return;
+    threads = std::max(1, threads);
+    grain = std::max(1LL, grain);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    for (int t = 0; t < threads; ++t)
+        queues.emplace_back(new WorkQueue());
+    long long share = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t) {
+        long long b = std::min(count, t * share), e = std::min(count, b + share);
+        if (b < e)
+            queues[t]->push(Range{ b, e });
+    }
+
+    std::atomic<long long> remaining(count);
+    auto worker = [&](int self) {
+        std::minstd_rand victimRng(static_cast<unsigned>(self) * 7919u + 1u);
+        Range r;
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            bool got = queues[self]->popBack(r);
+            for (int attempt = 0; !got && attempt < threads * 2; ++attempt) {
+                int victim = static_cast<int>(victimRng() % threads);
+                if (victim != self)
+                    got = queues[victim]->stealFront(r);
+            }
+            if (!got) {
+                std::this_thread::yield();
+                continue;
+            }
+            while (r.end - r.begin > grain) {
+                long long mid = r.begin + (r.end - r.begin) / 2;
+                queues[self]->push(Range{ mid, r.end });
+                r.end = mid;
+            }
+            body(self, r.begin, r.end);
+            remaining.fetch_sub(r.end - r.begin, std::memory_order_acq_rel);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool)
+        th.join();
+}
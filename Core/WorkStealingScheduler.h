@@ -0,0 +1,12 @@
+#pragma once
+#include <functional>
+
+// Розподіляє індекси [0, count) між потоками. Кожен потік ділить свій діапазон навпіл,
+// залишаючи другу половину у своїй черзі, а потік без роботи забирає діапазон із
+// початку черги іншого потоку.
+class WorkStealingScheduler {
+public:
+    typedef std::function<void(int worker, long long begin, long long end)> Body;
+
+    static void run(long long count, int threads, long long grain, const Body& body);
+};
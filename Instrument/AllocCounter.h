@@ -0,0 +1,6 @@
+#pragma once
+
+// Лічильник викликів глобального operator new. Заміна operator new живе в
+// AllocCounter.cpp, тому цей файл лінкується лише в інструменти заміру —
+// бенчмарк і seabattle_check_alloc (`make check-alloc`), — а не в ядро чи sim.
+long long allocationCount();
@@ -0,0 +1,134 @@
+#include "BoardRenderer.h"
+#include "Theme.h"
+
+void BoardRenderer::draw(sf::RenderTarget& target, const Board& board, const sf::Vector2f& offset, int cellPixels, int highlightSize, int highlightX, int highlightY, bool highlightVertical, bool highlightValid) {
+    int n = board.getSize();
+    if (n != gridSize || cellPixels != cellSize || board.revealsShips() != showShips) {
+        gridSize = n;
+        cellSize = cellPixels;
+        showShips = board.revealsShips();
+        rebuild(board);
+    }
+    else {
+        BitBoard changed = (board.shipCells() ^ drawnShips) | (board.missCells() ^ drawnMisses) |
+                           (board.hitCells() ^ drawnHits) | (board.sunkCells() ^ drawnSunk);
+        if (changed.any())
+            patch(board, changed);
+    }
+    drawnShips = board.shipCells();
+    drawnMisses = board.missCells();
+    drawnHits = board.hitCells();
+    drawnSunk = board.sunkCells();
+
+    sf::Vector2f origin(offset.x - MARGIN, offset.y - MARGIN);
+    if (cached) {
+        sprite.setPosition(origin);
+        target.draw(sprite);
+    }
+    else {
+        sf::Transform shift;
+        shift.translate(origin.x, origin.y);
+        target.draw(cells, sf::RenderStates(shift));
+    }
+
+    if (highlightSize > 0 && highlightX >= 0 && highlightY >= 0) {
+        overlay.clear();
+        sf::Color color = highlightValid ? theme.highlightGood : theme.highlightBad;
+        for (int i = 0; i < highlightSize; ++i) {
+            int nx = highlightX + (highlightVertical ? 0 : i);
+            int ny = highlightY + (highlightVertical ? i : 0);
+            if (nx < 0 || ny < 0 || nx >= n || ny >= n)
+                continue;
+            float x = offset.x + nx * cellSize, y = offset.y + ny * cellSize;
+            appendQuad(overlay, x, y, x + cellSize - 1, y + cellSize - 1, color);
+        }
+        target.draw(overlay);
+    }
+}
+
+void BoardRenderer::rebuild(const Board& board) {
+    cells.resize(static_cast<size_t>(gridSize) * gridSize * VERTS_PER_CELL);
+    for (int r = 0; r < gridSize; ++r)
+        for (int c = 0; c < gridSize; ++c)
+            writeCell(board, c, r);
+
+    unsigned side = static_cast<unsigned>(gridSize * cellSize + MARGIN * 2);
+    cached = canvas.create(side, side);
+    if (!cached)
+        return;
+    sprite.setTexture(canvas.getTexture(), true);
+    canvas.clear(sf::Color::Transparent);
+    canvas.draw(cells);
+    canvas.display();
+}
+
+// Плитки змінених клітинок спершу стираються до прозорості (BlendNone),
+// потім на них лягають заново записані вершини клітинок.
+void BoardRenderer::patch(const Board& board, const BitBoard& changed) {
+    int count = changed.count();
+    patchCells.resize(static_cast<size_t>(count) * VERTS_PER_CELL);
+    patchClear.resize(static_cast<size_t>(count) * 4);
+    int i = 0;
+    changed.forEach([&](int c, int r) {
+        writeCell(board, c, r);
+        const sf::Vertex* src = &cells[static_cast<size_t>(r * gridSize + c) * VERTS_PER_CELL];
+        for (int k = 0; k < VERTS_PER_CELL; ++k)
+            patchCells[static_cast<size_t>(i) * VERTS_PER_CELL + k] = src[k];
+        float x0, y0, x1, y1;
+        tileRect(c, r, x0, y0, x1, y1);
+        setQuad(&patchClear[static_cast<size_t>(i) * 4], x0, y0, x1, y1, sf::Color::Transparent);
+        ++i;
+    });
+    if (!cached)
+        return;
+    canvas.draw(patchClear, sf::RenderStates(sf::BlendNone));
+    canvas.draw(patchCells);
+    canvas.display();
+}
+
+void BoardRenderer::setQuad(sf::Vertex* v, float x0, float y0, float x1, float y1, const sf::Color& color) {
+    v[0] = sf::Vertex(sf::Vector2f(x0, y0), color);
+    v[1] = sf::Vertex(sf::Vector2f(x1, y0), color);
+    v[2] = sf::Vertex(sf::Vector2f(x1, y1), color);
+    v[3] = sf::Vertex(sf::Vector2f(x0, y1), color);
+}
+
+void BoardRenderer::appendQuad(sf::VertexArray& va, float x0, float y0, float x1, float y1, const sf::Color& color) {
+    sf::Vertex v[4];
+    setQuad(v, x0, y0, x1, y1, color);
+    for (const auto& vert : v)
+        va.append(vert);
+}
+
+// Плитка клітинки в координатах текстури: однопіксельний проміжок зліва й згори
+// плюс заливка (cellSize - 1) x (cellSize - 1). Плитки сусідів не перетинаються.
+void BoardRenderer::tileRect(int c, int r, float& x0, float& y0, float& x1, float& y1) const {
+    x0 = static_cast<float>(MARGIN - 1 + c * cellSize);
+    y0 = static_cast<float>(MARGIN - 1 + r * cellSize);
+    x1 = x0 + cellSize;
+    y1 = y0 + cellSize;
+}
+
+void BoardRenderer::writeCell(const Board& board, int c, int r) {
+    sf::Color fill;
+    switch (board.cellState(c, r)) {
+    case Empty:    fill = theme.cellEmpty; break;
+    case ShipCell: fill = showShips ? theme.cellShip : theme.cellEmpty; break;
+    case Miss:     fill = theme.cellMiss; break;
+    case Hit:      fill = theme.cellHit; break;
+    }
+    if (board.isSunkCell(Coord(c, r)))
+        fill = theme.cellSunk;
+
+    float x0, y0, x1, y1;
+    tileRect(c, r, x0, y0, x1, y1);
+    sf::Color border = board.isShotCell(c, r) ? theme.borderShot : sf::Color::Transparent;
+
+    sf::Vertex* v = &cells[static_cast<size_t>(r * gridSize + c) * VERTS_PER_CELL];
+    setQuad(v, x0 + 1, y0 + 1, x1, y1, fill);
+    // Рамка — кільце товщиною 2 всередині плитки; смуги не перекриваються.
+    setQuad(v + 4, x0, y0, x1, y0 + 2, border);
+    setQuad(v + 8, x0, y1 - 2, x1, y1, border);
+    setQuad(v + 12, x0, y0 + 2, x0 + 2, y1 - 2, border);
+    setQuad(v + 16, x1 - 2, y0 + 2, x1, y1 - 2, border);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Core/BitBoard.h"
+#include "Core/Board.h"
+#include <SFML/Graphics.hpp>
+
+// Малює поле з кешу в sf::RenderTexture: за кадр — один спрайт і підсвітка розміщення.
+// Клітинка займає власну плитку (проміжок зліва-згори плюс заливка), тож при зміні
+// стану в Board перемальовуються лише плитки змінених клітинок. Повна перебудова —
+// лише при зміні розміру поля, розміру клітинки чи видимості кораблів.
+class BoardRenderer {
+public:
+    void draw(sf::RenderTarget& target, const Board& board, const sf::Vector2f& offset, int cellPixels, int highlightSize = 0, int highlightX = -1, int highlightY = -1, bool highlightVertical = false, bool highlightValid = false);
+
+private:
+    // Заливка клітинки (4 вершини) і рамка пострілу товщиною 2 (4 смуги по 4 вершини).
+    static const int VERTS_PER_CELL = 20;
+    // Поле текстури навколо сітки, у пікселях.
+    static const int MARGIN = 2;
+
+    static void setQuad(sf::Vertex* v, float x0, float y0, float x1, float y1, const sf::Color& color);
+    static void appendQuad(sf::VertexArray& va, float x0, float y0, float x1, float y1, const sf::Color& color);
+    void rebuild(const Board& board);
+    void patch(const Board& board, const BitBoard& changed);
+    void writeCell(const Board& board, int c, int r);
+    void tileRect(int c, int r, float& x0, float& y0, float& x1, float& y1) const;
+
+    sf::RenderTexture canvas;
+    sf::Sprite sprite;
+    // Якщо RenderTexture недоступна, поле малюється напряму з cells.
+    bool cached = false;
+    sf::VertexArray cells{ sf::Quads };
+    sf::VertexArray patchCells{ sf::Quads };
+    sf::VertexArray patchClear{ sf::Quads };
+    sf::VertexArray overlay{ sf::Quads };
+    BitBoard drawnShips, drawnMisses, drawnHits, drawnSunk;
+    int gridSize = 0;
+    int cellSize = 0;
+    bool showShips = false;
+};
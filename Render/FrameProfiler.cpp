@@ -0,0 +1,84 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+double millis(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+}
+
+void FrameProfiler::beginFrame() {
+    frameStart = lastMark = Clock::now();
+    current.fill(0.0);
+}
+
+void FrameProfiler::mark(FramePhase phase) {
+    Clock::time_point now = Clock::now();
+    current[phase] += millis(now - lastMark);
+    lastMark = now;
+}
+
+void FrameProfiler::endFrame(const char* screen) {
+    double total = millis(Clock::now() - frameStart);
+    int slot = static_cast<int>(frameCount % HISTORY);
+    frameMs[slot] = static_cast<float>(total);
+    for (int p = 0; p < PHASE_COUNT; ++p)
+        phaseMs[slot][p] = static_cast<float>(current[p]);
+
+    if (trace.is_open()) {
+        trace << frameCount << ',' << screen << ',' << total;
+        for (int p = 0; p < PHASE_COUNT; ++p)
+            trace << ',' << current[p];
+        trace << '\n';
+    }
+    ++frameCount;
+}
+
+bool FrameProfiler::openTrace(const std::string& path) {
+    trace.open(path);
+    if (!trace)
+        return false;
+    trace << std::fixed << std::setprecision(3) << "frame,screen,total_ms";
+    for (int p = 0; p < PHASE_COUNT; ++p)
+        trace << ',' << phaseName(static_cast<FramePhase>(p)) << "_ms";
+    trace << '\n';
+    return true;
+}
+
+int FrameProfiler::frames() const {
+    return static_cast<int>(std::min<long long>(frameCount, HISTORY));
+}
+
+double FrameProfiler::framePercentile(double q) const {
+    int n = frames();
+    if (n == 0)
+        return 0.0;
+    std::array<float, HISTORY> sorted = frameMs;
+    int k = std::min(n - 1, static_cast<int>(q * (n - 1) + 0.5));
+    std::nth_element(sorted.begin(), sorted.begin() + k, sorted.begin() + n);
+    return sorted[k];
+}
+
+double FrameProfiler::phaseMean(FramePhase phase) const {
+    int n = frames();
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+        sum += phaseMs[i][phase];
+    return n ? sum / n : 0.0;
+}
+
+double FrameProfiler::phaseMax(FramePhase phase) const {
+    int n = frames();
+    float best = 0.f;
+    for (int i = 0; i < n; ++i)
+        best = std::max(best, phaseMs[i][phase]);
+    return best;
+}
+
+const char* FrameProfiler::phaseName(FramePhase phase) {
+    static const char* names[PHASE_COUNT] = { "events", "update", "boards", "ui", "minimap", "display" };
+    return names[phase];
+}
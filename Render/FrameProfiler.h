@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+// Фази кадру в Game::run. PhaseDisplay — лише обмін буферів: обмежувач FPS чекає
+// після endFrame, тож час кадру і перцентилі показують саму роботу, а не 16,7 мс.
+enum FramePhase { PhaseEvents, PhaseUpdate, PhaseBoards, PhaseUi, PhaseMiniMap, PhaseDisplay, PHASE_COUNT };
+
+// Заміри часу кадру: кільцевий буфер останніх кадрів для HUD і, за бажанням,
+// покадровий CSV-журнал. Під час гри нічого не виділяє.
+class FrameProfiler {
+public:
+    static const int HISTORY = 256;
+
+    void beginFrame();
+    // Додає до фази час, що минув від попередньої позначки.
+    void mark(FramePhase phase);
+    void endFrame(const char* screen);
+
+    bool openTrace(const std::string& path);
+
+    // Час кадру в мс для частки q (0..1) серед останніх HISTORY кадрів.
+    double framePercentile(double q) const;
+    double phaseMean(FramePhase phase) const;
+    double phaseMax(FramePhase phase) const;
+    int frames() const;
+
+    static const char* phaseName(FramePhase phase);
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point frameStart, lastMark;
+    std::array<double, PHASE_COUNT> current{};
+    std::array<float, HISTORY> frameMs{};
+    std::array<std::array<float, PHASE_COUNT>, HISTORY> phaseMs{};
+    long long frameCount = 0;
+    std::ofstream trace;
+};
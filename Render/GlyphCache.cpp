@@ -0,0 +1,25 @@
+#include "GlyphCache.h"
+
+namespace {
+
+template <class F>
+void forEachUiCodePoint(F f) {
+    for (sf::Uint32 c = 0x20; c < 0x7F; ++c) f(c);
+    for (sf::Uint32 c = 0x0410; c <= 0x044F; ++c) f(c);
+    static const sf::Uint32 extra[] = {
+        0x0404, 0x0406, 0x0407, 0x0490, 0x0454, 0x0456, 0x0457, 0x0491,  // Є І Ї Ґ є і ї ґ
+        0x2013, 0x2014, 0x2190, 0x2191, 0x2192, 0x2193                   // – — ← ↑ → ↓
+    };
+    for (sf::Uint32 c : extra) f(c);
+}
+
+}
+
+void prewarmGlyphs(const sf::Font& font, std::initializer_list<unsigned> sizes) {
+    for (unsigned size : sizes) {
+        forEachUiCodePoint([&](sf::Uint32 c) {
+            font.getGlyph(c, size, false);
+            font.getGlyph(c, size, true);
+        });
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <initializer_list>
+
+// Растеризує заздалегідь усі символи інтерфейсу (ASCII, кирилиця, стрілки й тире)
+// для кожного з розмірів, звичайним і жирним накресленням, щоб перша поява
+// нового розміру чи літери не давала ривка посеред гри.
+void prewarmGlyphs(const sf::Font& font, std::initializer_list<unsigned> sizes);
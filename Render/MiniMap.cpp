@@ -0,0 +1,52 @@
+#include "MiniMap.h"
+#include "Theme.h"
+
+void MiniMap::draw(sf::RenderTarget& target, const Board& left, const Board& right, const sf::Vector2f& pos, int cellPixels) {
+    int n = left.getSize();
+    bool changed = false;
+    if (n != gridSize) {
+        gridSize = n;
+        image.create(widthCells(n), n, sf::Color::Transparent);
+        texture.create(widthCells(n), n);
+        sprite.setTexture(texture, true);
+        for (int side = 0; side < 2; ++side) {
+            const Board& board = side ? right : left;
+            for (int y = 0; y < n; ++y)
+                for (int x = 0; x < n; ++x)
+                    writeCell(side, board, x, y);
+            drawnShots[side] = board.missCells() | board.hitCells();
+            drawnSunk[side] = board.sunkCells();
+        }
+        changed = true;
+    }
+    else {
+        changed |= sync(0, left);
+        changed |= sync(1, right);
+    }
+    if (changed)
+        texture.update(image);
+
+    sprite.setPosition(pos);
+    sprite.setScale(static_cast<float>(cellPixels), static_cast<float>(cellPixels));
+    target.draw(sprite);
+}
+
+bool MiniMap::sync(int side, const Board& board) {
+    BitBoard shots = board.missCells() | board.hitCells();
+    BitBoard changed = (shots ^ drawnShots[side]) | (board.sunkCells() ^ drawnSunk[side]);
+    if (!changed.any())
+        return false;
+    changed.forEach([&](int x, int y) { writeCell(side, board, x, y); });
+    drawnShots[side] = shots;
+    drawnSunk[side] = board.sunkCells();
+    return true;
+}
+
+void MiniMap::writeCell(int side, const Board& board, int x, int y) {
+    sf::Color color = theme.miniCellEmpty;
+    if (board.isSunkCell(Coord(x, y)))
+        color = theme.miniCellSunk;
+    else if (board.isShotCell(x, y))
+        color = theme.miniCellShot;
+    image.setPixel(static_cast<unsigned>(x + side * (gridSize + 1)), static_cast<unsigned>(y), color);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Core/BitBoard.h"
+#include "Core/Board.h"
+#include <SFML/Graphics.hpp>
+
+// Мінікарта обох полів: одна текстура з пікселем на клітинку (поля поруч через
+// порожній стовпчик). Пікселі переписуються лише для клітинок, чий стан змінився
+// з минулого кадру, а на екран текстура йде одним масштабованим спрайтом.
+class MiniMap {
+public:
+    void draw(sf::RenderTarget& target, const Board& left, const Board& right, const sf::Vector2f& pos, int cellPixels);
+
+    // Ширина мінікарти в клітинках.
+    static int widthCells(int gridSize) { return gridSize * 2 + 1; }
+
+private:
+    bool sync(int side, const Board& board);
+    void writeCell(int side, const Board& board, int x, int y);
+
+    sf::Image image;
+    sf::Texture texture;
+    sf::Sprite sprite;
+    BitBoard drawnShots[2], drawnSunk[2];
+    int gridSize = 0;
+};
@@ -0,0 +1,14 @@
+#include "Theme.h"
+
+ThemeColors theme;
+
+std::vector<ThemeColors> themes = {
+    ThemeColors{},
+    ThemeColors{
+        sf::Color(220,220,220), sf::Color(200,200,200), sf::Color(120,180,220), sf::Color(180,180,180),
+        sf::Color(220,80,80), sf::Color(80,180,220), sf::Color(255,200,0,180), sf::Color(60,220,60,100),
+        sf::Color(220,60,60,100), sf::Color(40,40,40), sf::Color(120,120,120), sf::Color(60,220,60),
+        sf::Color(80,180,220), sf::Color(255,200,0), sf::Color(200,200,200), sf::Color(255,200,0),
+        sf::Color(80,180,220), sf::Color(120,120,120), sf::Color(200,200,200,180)
+    }
+};
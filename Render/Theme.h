@@ -0,0 +1,29 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+struct ThemeColors {
+    sf::Color bgColor = sf::Color(30, 20, 10);
+    sf::Color cellEmpty = sf::Color(40, 30, 20);
+    sf::Color cellShip = sf::Color(80, 60, 40);
+    sf::Color cellMiss = sf::Color(120, 100, 80);
+    sf::Color cellHit = sf::Color(200, 60, 30);
+    sf::Color cellSunk = sf::Color(30, 120, 200);
+    sf::Color borderShot = sf::Color(255, 255, 0, 180);
+    sf::Color highlightGood = sf::Color(60, 220, 60, 100);
+    sf::Color highlightBad = sf::Color(220, 60, 60, 100);
+    sf::Color textMain = sf::Color(220, 200, 160);
+    sf::Color textAccent = sf::Color(220, 180, 60);
+    sf::Color textSuccess = sf::Color(60, 220, 60);
+    sf::Color miniCellSunk = sf::Color(30, 120, 200);
+    sf::Color miniCellShot = sf::Color(220, 180, 60);
+    sf::Color miniCellEmpty = sf::Color(60, 50, 40);
+    sf::Color hint = sf::Color(220, 180, 60);
+    sf::Color menuTitle = sf::Color(220, 180, 60);
+    sf::Color menuInfo = sf::Color(120, 100, 80);
+    sf::Color panelBg = sf::Color(20, 20, 20, 180);
+};
+
+// Поточна тема і список доступних тем.
+extern ThemeColors theme;
+extern std::vector<ThemeColors> themes;
@@ -1,395 +1,164 @@
 ﻿#include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include "Core/AIWorker.h"
+#include "Core/BitBoard.h"
+#include "Core/Board.h"
+#include "Core/FleetGenerator.h"
+#include "Core/Replay.h"
+#include "Core/Rng.h"
+#include "Render/BoardRenderer.h"
+#include "Render/FrameProfiler.h"
+#include "Render/GlyphCache.h"
+#include "Render/MiniMap.h"
+#include "Render/Theme.h"
 #include <vector>
 #include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
 #include <random>
-#include <ctime>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
-#include <queue>
 
-int CELL_SIZE = 30;
-int GRID_SIZE = 10;
-int PADDING = 50;
+const int PADDING = 50;
 const int BOTTOM_PANEL = 110;
-int WINDOW_WIDTH = GRID_SIZE * CELL_SIZE * 2 + PADDING * 3;
-int WINDOW_HEIGHT = GRID_SIZE * CELL_SIZE + PADDING * 2 + BOTTOM_PANEL;
-
-struct ThemeColors {
-    sf::Color bgColor = sf::Color(30, 20, 10);
-    sf::Color cellEmpty = sf::Color(40, 30, 20);
-    sf::Color cellShip = sf::Color(80, 60, 40);
-    sf::Color cellMiss = sf::Color(120, 100, 80);
-    sf::Color cellHit = sf::Color(200, 60, 30);
-    sf::Color cellSunk = sf::Color(30, 120, 200);
-    sf::Color borderShot = sf::Color(255, 255, 0, 180);
-    sf::Color highlightGood = sf::Color(60, 220, 60, 100);
-    sf::Color highlightBad = sf::Color(220, 60, 60, 100);
-    sf::Color textMain = sf::Color(220, 200, 160);
-    sf::Color textAccent = sf::Color(220, 180, 60);
-    sf::Color textSuccess = sf::Color(60, 220, 60);
-    sf::Color miniCellSunk = sf::Color(30, 120, 200);
-    sf::Color miniCellShot = sf::Color(220, 180, 60);
-    sf::Color miniCellEmpty = sf::Color(60, 50, 40);
-    sf::Color hint = sf::Color(220, 180, 60);
-    sf::Color menuTitle = sf::Color(220, 180, 60);
-    sf::Color menuInfo = sf::Color(120, 100, 80);
-    sf::Color panelBg = sf::Color(20, 20, 20, 180);
-};
-ThemeColors theme; 
-
-enum CellState { Empty, ShipCell, Miss, Hit };
-
-struct Ship {
-    int size;
-    std::vector<sf::Vector2i> positions;
-    int hits = 0;
-    bool isSunk() const { return hits >= size; }
-};
-
-struct Effect {
-    sf::CircleShape shape;
-    float lifetime = 0.f;
-    bool isWave = false;
-    float wavePhase = 0.f;
-
-    bool isExplosion = false;
-    float explosionPhase = 0.f;
-    sf::Vector2f explosionCenter;
-};
-
-struct Settings {
-    int aiLevel = 1;
-    int gridSize = 10;
-    std::vector<int> shipSet = { 5,4,3,3,2 };
-    int themeIdx = 0; 
-    bool showHints = false; 
-};
-
-std::vector<ThemeColors> themes = {
-    ThemeColors{},
-    ThemeColors{
-        sf::Color(220,220,220), sf::Color(200,200,200), sf::Color(120,180,220), sf::Color(180,180,180),
-        sf::Color(220,80,80), sf::Color(80,180,220), sf::Color(255,200,0,180), sf::Color(60,220,60,100),
-        sf::Color(220,60,60,100), sf::Color(40,40,40), sf::Color(120,120,120), sf::Color(60,220,60),
-        sf::Color(80,180,220), sf::Color(255,200,0), sf::Color(200,200,200), sf::Color(255,200,0),
-        sf::Color(80,180,220), sf::Color(120,120,120), sf::Color(200,200,200,180)
-    }
-};
-class Board {
+// Клітинка у віконному режимі за замовчуванням і межі, в яких вона підлаштовується під вікно.
+const int DEFAULT_CELL_SIZE = 30;
+const int MIN_CELL_SIZE = 12;
+const int MAX_CELL_SIZE = 60;
+// Скільки секунд після потоплення корабля над потопленими клітинками ще здіймаються хвилі.
+const float SUNK_WAVE_DURATION = 3.f;
+// Обмеження частоти кадрів; чекає сам цикл після endFrame, тож очікування не потрапляє в заміри.
+const sf::Time FRAME_TIME = sf::seconds(1.f / 60.f);
+
+enum ParticleKind : std::uint8_t { Splash, Wave, Explosion };
+
+// Пул частинок фіксованої місткості у вигляді структури масивів.
+// Видалення — перестановка з останнім елементом, малювання — один масив трикутників.
+class ParticlePool {
 public:
-    Board(bool revealShips, const Settings& settings)
-        : showShips(revealShips), settings(settings), grid(settings.gridSize, std::vector<CellState>(settings.gridSize, Empty))
-    {
-        if (revealShips)
-            ;
-        else
-            placeAllShips();
-    }
-
-    bool isAreaFree(int row, int col, int gridSize, const std::vector<std::vector<CellState>>& grid) const {
-        for (int dr = -1; dr <= 1; ++dr) {
-            for (int dc = -1; dc <= 1; ++dc) {
-                int nr = row + dr, nc = col + dc;
-                if (nr >= 0 && nr < gridSize && nc >= 0 && nc < gridSize) {
-                    if (grid[nr][nc] == ShipCell) return false;
-                }
-            }
-        }
-        return true;
-    }
-
-    void placeAllShips() {
-        ships.clear();
-        for (auto& row : grid)
-            std::fill(row.begin(), row.end(), Empty);
-
-        std::mt19937 rng(static_cast<unsigned>(std::time(nullptr)));
-        std::uniform_int_distribution<int> dirDist(0, 1);
-        std::uniform_int_distribution<int> coordDist(0, settings.gridSize - 1);
-
-        for (int sz : settings.shipSet) {
-            bool placed = false;
-            int attempts = 0;
-            while (!placed && attempts < 1000) {
-                int dir = dirDist(rng);
-                int row = coordDist(rng);
-                int col = coordDist(rng);
-                std::vector<sf::Vector2i> pos;
-
-                bool canPlace = true;
-                for (int i = 0; i < sz; ++i) {
-                    int r = row + (dir == 0 ? i : 0);
-                    int c = col + (dir == 1 ? i : 0);
-                    if (r < 0 || r >= settings.gridSize || c < 0 || c >= settings.gridSize ||
-                        grid[r][c] != Empty || !isAreaFree(r, c, settings.gridSize, grid)) {
-                        canPlace = false;
-                        break;
-                    }
-                    pos.emplace_back(c, r);
-                }
-
-                if (canPlace && pos.size() == sz) {
-                    Ship ship{ sz, pos };
-                    for (auto& p : pos)
-                        grid[p.y][p.x] = ShipCell;
-                    ships.push_back(ship);
-                    placed = true;
-                }
-                attempts++;
-            }
-        }
-    }
-
-    bool canPlaceShip(int x, int y, int size, bool vertical) const {
-        for (int i = 0; i < size; ++i) {
-            int nx = x + (vertical ? 0 : i);
-            int ny = y + (vertical ? i : 0);
-            if (nx < 0 || ny < 0 || nx >= settings.gridSize || ny >= settings.gridSize)
-                return false;
-            if (grid[ny][nx] != Empty || !isAreaFree(ny, nx, settings.gridSize, grid))
-                return false;
-        }
-        return true;
-    }
-
-    void placeShipManual(int x, int y, int size, bool vertical) {
-        std::vector<sf::Vector2i> pos;
-        for (int i = 0; i < size; ++i) {
-            int nx = x + (vertical ? 0 : i);
-            int ny = y + (vertical ? i : 0);
-            grid[ny][nx] = ShipCell;
-            pos.emplace_back(nx, ny);
-        }
-        ships.push_back(Ship{ size, pos });
-    }
+    static const int CAPACITY = 1024;
+    // Ключ дедуплікації: індекс поля * 256 + індекс клітинки.
+    static const int MAX_KEYS = 2 * BIT_STRIDE * BIT_STRIDE;
 
-    void clearShips() {
-        for (auto& row : grid)
-            std::fill(row.begin(), row.end(), Empty);
-        ships.clear();
-    }
+    ParticlePool() { activeKeys.fill(false); }
 
-    void setShips(const std::vector<Ship>& newShips, const std::vector<std::vector<CellState>>& newGrid) {
-        ships = newShips;
-        grid = newGrid;
-    }
-
-    bool receiveShot(const sf::Vector2i& cell) {
-        if (cell.x < 0 || cell.x >= settings.gridSize || cell.y < 0 || cell.y >= settings.gridSize)
-            return false;
-        CellState& cs = grid[cell.y][cell.x];
-        if (cs == Empty) {
-            cs = Miss;
+    bool spawn(ParticleKind kind, const sf::Vector2f& pos, const sf::Vector2f& vel, float radius, const sf::Color& color, float lifetime, int key = -1) {
+        if (count == CAPACITY)
             return false;
-        }
-        if (cs == ShipCell) {
-            cs = Hit;
-            for (auto& ship : ships) {
-                for (auto& p : ship.positions) {
-                    if (p == cell) {
-                        ship.hits++;
-                        break;
-                    }
-                }
-            }
-            return true;
-        }
-        return false;
-    }
-
-    bool allSunk() const {
-        for (const auto& ship : ships)
-            if (ship.hits < ship.size)
-                return false;
+        int i = count++;
+        kinds[i] = kind;
+        posX[i] = pos.x;
+        posY[i] = pos.y;
+        velX[i] = vel.x;
+        velY[i] = vel.y;
+        radii[i] = radius;
+        scales[i] = 1.f;
+        colors[i] = color;
+        life[i] = lifetime;
+        maxLife[i] = lifetime;
+        phases[i] = 0.f;
+        keys[i] = static_cast<std::int16_t>(key);
+        if (key >= 0)
+            activeKeys[key] = true;
         return true;
     }
 
-    bool isSunkCell(const sf::Vector2i& cell) const {
-        for (const auto& ship : ships) {
-            if (ship.isSunk()) {
-                for (const auto& p : ship.positions) {
-                    if (p == cell) return true;
-                }
-            }
-        }
-        return false;
-    }
+    bool hasKey(int key) const { return activeKeys[key]; }
 
-    bool isShotCell(int x, int y) const {
-        return grid[y][x] == Miss || grid[y][x] == Hit;
-    }
+    int size() const { return count; }
 
-    bool isHitCell(int x, int y) const {
-        return grid[y][x] == Hit;
+    void clear() {
+        count = 0;
+        activeKeys.fill(false);
     }
 
-    bool isMissCell(int x, int y) const {
-        return grid[y][x] == Miss;
-    }
-
-    bool isShipCell(int x, int y) const {
-        return grid[y][x] == ShipCell;
-    }
-
-    int getSize() const { return settings.gridSize; }
-
-    const std::vector<Ship>& getShips() const { return ships; }
-
-    void draw(sf::RenderWindow& win, const sf::Vector2f& offset, std::vector<Effect>& effects, int highlightSize = 0, int highlightX = -1, int highlightY = -1, bool highlightVertical = false, bool highlightValid = false, bool showAllShips = false) const {
-        sf::RectangleShape cellShape(sf::Vector2f(CELL_SIZE - 1, CELL_SIZE - 1));
-        sf::RectangleShape border(sf::Vector2f(CELL_SIZE - 1, CELL_SIZE - 1));
-        border.setFillColor(sf::Color::Transparent);
-        border.setOutlineThickness(2);
-
-        for (int r = 0; r < settings.gridSize; ++r) {
-            for (int c = 0; c < settings.gridSize; ++c) {
-                cellShape.setPosition(offset.x + c * CELL_SIZE, offset.y + r * CELL_SIZE);
-                border.setPosition(cellShape.getPosition());
-
-                sf::Vector2i cell(c, r);
-
-                bool revealShip = showAllShips && isShipCell(c, r);
-
-                switch (grid[r][c]) {
-                case Empty:    cellShape.setFillColor(sf::Color(40, 30, 20)); break;
-                case ShipCell: cellShape.setFillColor(showShips ? sf::Color(80, 60, 40) : sf::Color(40, 30, 20)); break;
-                case Miss:     cellShape.setFillColor(sf::Color(120, 100, 80)); break;
-                case Hit:      cellShape.setFillColor(sf::Color(200, 60, 30)); break;
-                }
-
-                if (isSunkCell(cell)) {
-                    cellShape.setFillColor(sf::Color(30, 120, 200));
-                    bool found = false;
-                    for (const auto& e : effects) {
-                        if (e.isWave && e.shape.getPosition() == cellShape.getPosition())
-                            found = true;
-                    }
-                    if (!found) {
-                        Effect wave;
-                        float radius = CELL_SIZE / 2 - 2;
-                        wave.shape = sf::CircleShape(radius);
-                        wave.shape.setOrigin(radius, radius);
-                        wave.shape.setPosition(cellShape.getPosition().x + CELL_SIZE / 2, cellShape.getPosition().y + CELL_SIZE / 2);
-                        wave.lifetime = 1.5f;
-                        wave.isWave = true;
-                        wave.wavePhase = 0.f;
-                        effects.push_back(wave);
-                    }
-                }
-
-
-
-                win.draw(cellShape);
-
-                if (isShotCell(c, r)) {
-                    border.setOutlineColor(sf::Color(255, 255, 0, 180));
-                    win.draw(border);
-                }
+    void update(float dt) {
+        for (int i = 0; i < count;) {
+            life[i] -= dt;
+            float ratio = std::max(life[i] / maxLife[i], 0.f);
+            switch (kinds[i]) {
+            case Splash:
+                scales[i] = 1.f + (1.f - ratio);
+                colors[i].a = static_cast<sf::Uint8>(255 * ratio);
+                break;
+            case Wave:
+                phases[i] += dt * 2.5f;
+                scales[i] = 1.0f + 0.2f * std::sin(phases[i] * 3.14f);
+                colors[i].a = static_cast<sf::Uint8>(180 * std::max(0.f, 1.0f - phases[i] / 2.0f));
+                break;
+            case Explosion:
+                posX[i] += velX[i] * dt;
+                posY[i] += velY[i] * dt;
+                velX[i] *= 1.f - std::min(1.f, 3.f * dt);
+                velY[i] *= 1.f - std::min(1.f, 3.f * dt);
+                scales[i] = 0.3f + 0.7f * ratio;
+                colors[i].a = static_cast<sf::Uint8>(255 * ratio);
+                break;
             }
+            if (life[i] <= 0.f) remove(i);
+            else ++i;
         }
+    }
 
-        if (highlightSize > 0 && highlightX >= 0 && highlightY >= 0) {
-            for (int i = 0; i < highlightSize; ++i) {
-                int nx = highlightX + (highlightVertical ? 0 : i);
-                int ny = highlightY + (highlightVertical ? i : 0);
-                if (nx < 0 || ny < 0 || nx >= settings.gridSize || ny >= settings.gridSize)
-                    continue;
-                sf::RectangleShape hl(sf::Vector2f(CELL_SIZE - 1, CELL_SIZE - 1));
-                hl.setPosition(offset.x + nx * CELL_SIZE, offset.y + ny * CELL_SIZE);
-                hl.setFillColor(highlightValid ? sf::Color(60, 220, 60, 100) : sf::Color(220, 60, 60, 100));
-                win.draw(hl);
+    void draw(sf::RenderTarget& target) {
+        static std::array<sf::Vector2f, SEGMENTS + 1> unit = makeUnitCircle();
+        vertices.resize(static_cast<size_t>(count) * SEGMENTS * 3);
+        size_t v = 0;
+        for (int i = 0; i < count; ++i) {
+            sf::Vector2f c(posX[i], posY[i]);
+            float r = radii[i] * scales[i];
+            for (int s = 0; s < SEGMENTS; ++s) {
+                vertices[v++] = sf::Vertex(c, colors[i]);
+                vertices[v++] = sf::Vertex(c + unit[s] * r, colors[i]);
+                vertices[v++] = sf::Vertex(c + unit[s + 1] * r, colors[i]);
             }
         }
+        if (count > 0)
+            target.draw(vertices);
     }
 
-    std::vector<std::vector<CellState>> grid;
-
 private:
-    std::vector<Ship> ships;
-    bool showShips;
-    Settings settings;
-};
-
-class AI {
-public:
-    AI(const Settings& settings) : settings(settings), grid(settings.gridSize, std::vector<int>(settings.gridSize, 0)) {}
-
-    void reset() {
-        grid.assign(settings.gridSize, std::vector<int>(settings.gridSize, 0));
-        huntMode = true;
-        targets = std::queue<sf::Vector2i>();
-        lastHit = sf::Vector2i(-1, -1);
-        lastDir = -1;
-        triedDirs.clear();
-    }
-
-    sf::Vector2i getMove(const Board& board, int aiLevel) {
-        int N = board.getSize();
-        if (aiLevel == 1) {
-            std::vector<sf::Vector2i> candidates;
-            for (int y = 0; y < N; ++y)
-                for (int x = 0; x < N; ++x)
-                    if (!board.isShotCell(x, y))
-                        candidates.emplace_back(x, y);
-            if (candidates.empty()) return sf::Vector2i(0, 0);
-            std::uniform_int_distribution<int> dist(0, (int)candidates.size() - 1);
-            return candidates[dist(rng)];
-        }
-
-        if (!targets.empty()) {
-            sf::Vector2i t = targets.front();
-            targets.pop();
-            return t;
-        }
-
-        for (int y = 0; y < N; ++y) {
-            for (int x = 0; x < N; ++x) {
-                if (board.isHitCell(x, y)) {
-                    for (auto d : dirs) {
-                        int nx = x + d.x, ny = y + d.y;
-                        if (nx >= 0 && nx < N && ny >= 0 && ny < N && !board.isShotCell(nx, ny)) {
-                            targets.push(sf::Vector2i(nx, ny));
-                        }
-                    }
-                }
-            }
-        }
+    static const int SEGMENTS = 16;
 
-        if (!targets.empty()) {
-            sf::Vector2i t = targets.front();
-            targets.pop();
-            return t;
+    static std::array<sf::Vector2f, SEGMENTS + 1> makeUnitCircle() {
+        std::array<sf::Vector2f, SEGMENTS + 1> pts;
+        for (int s = 0; s <= SEGMENTS; ++s) {
+            float a = 2.f * 3.14159265f * s / SEGMENTS;
+            pts[s] = sf::Vector2f(std::cos(a), std::sin(a));
         }
+        return pts;
+    }
 
-        std::vector<sf::Vector2i> candidates;
-        for (int y = 0; y < N; ++y)
-            for (int x = 0; x < N; ++x)
-                if (!board.isShotCell(x, y) && ((x + y) % 2 == 0))
-                    candidates.emplace_back(x, y);
-        if (candidates.empty()) {
-            for (int y = 0; y < N; ++y)
-                for (int x = 0; x < N; ++x)
-                    if (!board.isShotCell(x, y))
-                        candidates.emplace_back(x, y);
-        }
-        if (candidates.empty()) return sf::Vector2i(0, 0);
-        std::uniform_int_distribution<int> dist(0, (int)candidates.size() - 1);
-        return candidates[dist(rng)];
+    void remove(int i) {
+        if (keys[i] >= 0)
+            activeKeys[keys[i]] = false;
+        int last = --count;
+        kinds[i] = kinds[last];
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        radii[i] = radii[last];
+        scales[i] = scales[last];
+        colors[i] = colors[last];
+        life[i] = life[last];
+        maxLife[i] = maxLife[last];
+        phases[i] = phases[last];
+        keys[i] = keys[last];
     }
 
-private:
-    Settings settings;
-    std::vector<std::vector<int>> grid;
-    std::queue<sf::Vector2i> targets;
-    sf::Vector2i lastHit;
-    int lastDir = -1;
-    std::vector<int> triedDirs;
-    bool huntMode = true;
-    std::mt19937 rng{ static_cast<unsigned>(std::time(nullptr)) };
-    const std::vector<sf::Vector2i> dirs = { {1,0},{-1,0},{0,1},{0,-1} };
+    int count = 0;
+    std::array<ParticleKind, CAPACITY> kinds;
+    std::array<float, CAPACITY> posX, posY, velX, velY;
+    std::array<float, CAPACITY> radii, scales, life, maxLife, phases;
+    std::array<sf::Color, CAPACITY> colors;
+    std::array<std::int16_t, CAPACITY> keys;
+    std::array<bool, MAX_KEYS> activeKeys;
+    sf::VertexArray vertices{ sf::Triangles };
 };
 
 class Game {
@@ -397,21 +166,49 @@ public:
     enum Screen { MENU, PLACING_CHOICE, PLACING, PLAYING, SETTINGS, EXIT };
 
     Game()
-        : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), L"Морський бій"),
-        settings(), playerBoard(true, settings), aiBoard(false, settings), ai(settings), playerTurn(true), gameOver(false), screen(MENU), selected(0),
+        : window(windowedMode(Settings().gridSize), L"Морський бій"),
+        settings(), playerBoard(true, settings), aiBoard(false, settings), aiWorker(settings), playerTurn(true), gameOver(false), screen(MENU), selected(0),
         shots(0), hits(0), misses(0), consecMiss(0), fullscreen(false)
     {
-        window.setFramerateLimit(60);
-
         if (!font.loadFromFile("Resources/segoeuib.ttf") && !font.loadFromFile("Resources/segoeuib.ttf")) {
             std::cerr << "Помилка: не знайдено Resources/segoeui.ttf чи segoeuib.ttf" << std::endl;
             std::exit(EXIT_FAILURE);
         }
+        prewarmGlyphs(font, { 14, 16, 18, 20, 22, 24, 26, 28, 32, 40 });
+
         statusText.setFont(font);
         statusText.setCharacterSize(20);
         statusText.setFillColor(sf::Color(220, 200, 160));
         statusText.setPosition(PADDING, PADDING / 2);
 
+        statsText.setFont(font);
+        statsText.setCharacterSize(18);
+        statsText.setFillColor(sf::Color(220, 200, 160));
+
+        setUtf8(hintText, u8"Підказка: спробуйте стріляти \"шахівкою\" для пошуку кораблів!");
+        hintText.setFont(font);
+        hintText.setCharacterSize(18);
+        hintText.setFillColor(sf::Color(220, 180, 60));
+        hintText.setStyle(sf::Text::Bold);
+
+        setUtf8(titleText, u8"Морський бій");
+        titleText.setFont(font);
+        titleText.setCharacterSize(40);
+        titleText.setFillColor(sf::Color(220, 180, 60));
+        titleText.setStyle(sf::Text::Bold);
+        titleText.setPosition(PADDING + 30, PADDING);
+
+        setUtf8(menuInfoText, u8"Навігація: стрілки ВВЕРХ/ВНИЗ, Enter — вибрати\nF11 — повноекранний режим, F3 — час кадру");
+        menuInfoText.setFont(font);
+        menuInfoText.setCharacterSize(16);
+        menuInfoText.setFillColor(sf::Color(120, 100, 80));
+
+        setUtf8(warningText, fleetWarning);
+        warningText.setFont(font);
+        warningText.setCharacterSize(22);
+        warningText.setFillColor(sf::Color(220, 60, 60));
+        warningText.setPosition(PADDING + 40, PADDING + 230);
+
         menuItems = { u8"Нова гра", u8"Налаштування", u8"Вихід" };
         for (size_t i = 0; i < menuItems.size(); ++i) {
             std::string str = menuItems[i];
@@ -434,13 +231,11 @@ public:
         randomText.setCharacterSize(22);
         randomText.setFillColor(sf::Color(220, 180, 60));
         randomText.setString(sf::String::fromUtf8(u8"Випадково", u8"Випадково" + strlen(u8"Випадково")));
-        randomText.setPosition(PADDING + 40, WINDOW_HEIGHT - BOTTOM_PANEL + 10);
 
         playText.setFont(font);
         playText.setCharacterSize(22);
         playText.setFillColor(sf::Color(60, 220, 60));
         playText.setString(sf::String::fromUtf8(u8"Грати", u8"Грати" + strlen(u8"Грати")));
-        playText.setPosition(PADDING + 200, WINDOW_HEIGHT - BOTTOM_PANEL + 10);
 
         // Для выбора способа расстановки
         placeChoiceText1.setFont(font);
@@ -460,39 +255,111 @@ public:
         placeChoiceText3.setFillColor(sf::Color(60, 220, 60));
         placeChoiceText3.setString(sf::String::fromUtf8(u8"2 — Вручну", u8"2 — Вручну" + strlen(u8"2 — Вручну")));
         placeChoiceText3.setPosition(PADDING + 40, PADDING + 170);
+
+        relayout();
     }
 
-    void recreateWindow(bool toFullscreen = false) {
-        if (toFullscreen) {
-            auto mode = sf::VideoMode::getDesktopMode();
-            int maxCellW = (mode.width - PADDING * 3) / (settings.gridSize * 2);
-            int maxCellH = (mode.height - PADDING * 2 - BOTTOM_PANEL) / settings.gridSize;
-            CELL_SIZE = std::min(60, std::min(maxCellW, maxCellH));
-            GRID_SIZE = settings.gridSize;
-            WINDOW_WIDTH = GRID_SIZE * CELL_SIZE * 2 + PADDING * 3;
-            WINDOW_HEIGHT = GRID_SIZE * CELL_SIZE + PADDING * 2 + BOTTOM_PANEL;
-            window.create(mode, L"Морський бій", sf::Style::Fullscreen);
-        }
-        else {
-            CELL_SIZE = 30;
-            GRID_SIZE = settings.gridSize;
-            WINDOW_WIDTH = GRID_SIZE * CELL_SIZE * 2 + PADDING * 3;
-            WINDOW_HEIGHT = GRID_SIZE * CELL_SIZE + PADDING * 2 + BOTTOM_PANEL;
-            window.create(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), L"Морський бій", sf::Style::Default);
-        }
-        window.setFramerateLimit(60);
+    // Розмір сцени з клітинкою cell: два поля, відступи й нижня панель.
+    static sf::Vector2i sceneSize(int gridSize, int cell) {
+        return sf::Vector2i(gridSize * cell * 2 + PADDING * 3, gridSize * cell + PADDING * 2 + BOTTOM_PANEL);
+    }
+
+    static sf::VideoMode windowedMode(int gridSize) {
+        sf::Vector2i size = sceneSize(gridSize, DEFAULT_CELL_SIZE);
+        return sf::VideoMode(static_cast<unsigned>(size.x), static_cast<unsigned>(size.y));
+    }
+
+    // Вікно (і контекст OpenGL) створюється заново лише при справжньому перемиканні режиму.
+    void setFullscreen(bool on) {
+        fullscreen = on;
+        if (on)
+            window.create(sf::VideoMode::getDesktopMode(), L"Морський бій", sf::Style::Fullscreen);
+        else
+            window.create(windowedMode(settings.gridSize), L"Морський бій", sf::Style::Default);
+        relayout();
+    }
+
+    // Розмір клітинки підбирається під поточне вікно, а вид центрує сцену в ньому без
+    // масштабування, тож текст і клітинки лишаються чіткими. Викликається при зміні
+    // розміру поля, розміру вікна чи режиму.
+    void relayout() {
+        sf::Vector2u win = window.getSize();
+        int n = settings.gridSize;
+        int fitW = (static_cast<int>(win.x) - PADDING * 3) / (n * 2);
+        int fitH = (static_cast<int>(win.y) - PADDING * 2 - BOTTOM_PANEL) / n;
+        int cell = std::max(MIN_CELL_SIZE, std::min(MAX_CELL_SIZE, std::min(fitW, fitH)));
+        if (cell != cellSize)
+            particles.clear();
+        cellSize = cell;
+        scene = sceneSize(n, cellSize);
+
+        float left = std::floor((scene.x - static_cast<float>(win.x)) / 2.f);
+        float top = std::floor((scene.y - static_cast<float>(win.y)) / 2.f);
+        window.setView(sf::View(sf::FloatRect(left, top, static_cast<float>(win.x), static_cast<float>(win.y))));
+
+        float below = static_cast<float>(PADDING + n * cellSize + 20);
+        randomText.setPosition(PADDING + 10, below);
+        playText.setPosition(PADDING + 200, below);
+        statsText.setPosition(PADDING, static_cast<float>(scene.y - BOTTOM_PANEL + 10));
+        hintText.setPosition(PADDING, static_cast<float>(scene.y - BOTTOM_PANEL + 40));
+        menuInfoText.setPosition(PADDING + 30, static_cast<float>(scene.y - BOTTOM_PANEL + 10));
+        dirty = true;
+    }
+
+    sf::Vector2f playerOrigin() const { return sf::Vector2f(PADDING, PADDING); }
+    sf::Vector2f enemyOrigin() const { return sf::Vector2f(static_cast<float>(PADDING * 2 + settings.gridSize * cellSize), PADDING); }
+
+    sf::Vector2f toScene(const sf::Vector2i& pixel) const { return window.mapPixelToCoords(pixel); }
 
-        randomText.setPosition(PADDING + 40, WINDOW_HEIGHT - BOTTOM_PANEL + 10);
-        playText.setPosition(PADDING + 200, WINDOW_HEIGHT - BOTTOM_PANEL + 10);
+    bool openFrameTrace(const std::string& path) {
+        return profiler.openTrace(path);
+    }
+
+    // Зерно сесії: від нього відлічуються потоки RngService для кожного раунду.
+    void setSeed(std::uint64_t seed) {
+        session = RngService(seed);
+        roundNumber = 0;
+    }
+
+    // Каталог для записів партій; порожній рядок вимикає запис.
+    void setReplayDir(const std::string& dir) {
+        replayDir = dir;
+    }
+
+    // false — перемальовувати кожен кадр, як раніше (зручно для заміру через F3).
+    void setRenderOnDemand(bool enabled) {
+        renderOnDemand = enabled;
     }
 
     void run() {
+        static const char* screenNames[] = { "menu", "placing_choice", "placing", "playing", "settings", "exit" };
         sf::Clock clock;
         while (window.isOpen()) {
+            // Нічого не анімується і не змінилося: спимо до наступної події.
+            if (renderOnDemand && !dirty && !animating()) {
+                sf::Event event;
+                if (!window.waitEvent(event))
+                    continue;
+                clock.restart();
+                handleEvent(event);
+            }
+            profiler.beginFrame();
+            frameClock.restart();
             float dt = clock.restart().asSeconds();
             processEvents();
+            profiler.mark(PhaseEvents);
+            bool wasAnimating = animating();
             updateEffects(dt);
-
+            updateAI(dt);
+            profiler.mark(PhaseUpdate);
+            // Кадр, на якому анімація скінчилася, теж малюється: інакше до наступної події
+            // на екрані лишився б її останній стан.
+            if (animating() || wasAnimating)
+                dirty = true;
+            if (renderOnDemand && !dirty)
+                continue;
+
+            Screen drawn = screen;
             window.clear(sf::Color(30, 20, 10));
 
             switch (screen) {
@@ -509,20 +376,31 @@ public:
                 drawPlacing();
                 break;
             case PLAYING:
-                playerBoard.draw(window, sf::Vector2f(PADDING, PADDING), effects);
-                aiBoard.draw(window, sf::Vector2f(PADDING * 2 + settings.gridSize * CELL_SIZE, PADDING), effects);
+                playerView.draw(window, playerBoard, playerOrigin(), cellSize);
+                aiView.draw(window, aiBoard, enemyOrigin(), cellSize);
+                profiler.mark(PhaseBoards);
+                spawnSunkWaves();
                 drawHighlight();
                 drawEffects();
                 drawStats();
                 drawStatus();
                 drawHint();
+                profiler.mark(PhaseUi);
                 drawMiniMap();
+                profiler.mark(PhaseMiniMap);
                 break;
             case EXIT:
                 window.close();
                 break;
             }
+            if (showFrameStats)
+                drawFrameStats();
+            profiler.mark(PhaseUi);
             window.display();
+            dirty = false;
+            profiler.mark(PhaseDisplay);
+            profiler.endFrame(screenNames[drawn]);
+            sf::sleep(FRAME_TIME - frameClock.getElapsedTime());
         }
     }
 
@@ -530,13 +408,33 @@ private:
     sf::RenderWindow window;
     Settings settings;
     Board playerBoard, aiBoard;
-    AI ai;
+    BoardRenderer playerView, aiView;
+    MiniMap miniMap;
+    sf::RectangleShape miniMapBg;
+    AIWorker aiWorker;
+    ReplayWriter replay;
+    std::string replayDir = "replays";
+    // Скільки ще чекати до показу наступного пострілу ШІ, с.
+    float aiRevealTimer = 0.f;
     bool playerTurn;
     bool gameOver;
     sf::Font font;
-    sf::Text statusText;
-    std::mt19937 rng{ static_cast<unsigned>(std::time(nullptr)) };
-    std::vector<Effect> effects;
+    sf::Text statusText, statsText, hintText, titleText, menuInfoText, warningText;
+    // Що саме зараз показують закешовані рядки; -1 — ще нічого.
+    int statusShown = -1;
+    std::array<int, 3> statsShown{ { -1, -1, -1 } };
+    int menuSelectedShown = -1;
+    int placeShown = -1;
+    // Зерно всіх партій сесії: партія n грає з session.game(n), і її зерно пишеться в запис.
+    RngService session{ RngService::freshSeed() };
+    std::uint64_t roundNumber = 0;
+    RngService round;
+    Rng playerPlacement;
+    // Частинки не впливають на гру, тож мають окремий потік.
+    Rng rng = session.stream(RngStream::Effects);
+    ParticlePool particles;
+    // Залишок часу, поки spawnSunkWaves відновлює хвилі; потім частинки згасають і цикл засинає.
+    float sunkWaveTime = 0.f;
     sf::SoundBuffer hitBuffer, missBuffer;
     sf::Sound hitSound, missSound;
     sf::Music bgMusic;
@@ -552,155 +450,185 @@ private:
     int misses;
     int consecMiss;
     bool fullscreen;
+    // Поточне компонування: розмір клітинки в пікселях і розмір сцени, яку вид центрує у вікні.
+    int cellSize = DEFAULT_CELL_SIZE;
+    sf::Vector2i scene;
+    bool fleetFits = true;
+    const std::string fleetWarning = u8"Цей набір кораблів не вміщується на полі такого розміру.";
 
     int settingsSelected = 0;
     std::vector<std::string> settingsOptions = {
         u8"Складність ШІ: ",
         u8"Розмір поля: ",
         u8"Набір кораблів: ",
+        u8"Час ходу ШІ: ",
+        u8"Пауза між пострілами ШІ: ",
         u8"Назад"
     };
 
-    std::vector<int> shipsToPlace;
+    ShipSet shipsToPlace;
     int currentShipIdx = 0;
     bool placingVertical = false;
     sf::Text placeText, randomText, playText;
 
     sf::Text placeChoiceText1, placeChoiceText2, placeChoiceText3;
 
+    // Кадр малюється лише після події чи зміни стану або поки йде анімація частинок.
+    bool renderOnDemand = true;
+    bool dirty = true;
+
+    FrameProfiler profiler;
+    // Від початку кадру: скільки ще спати до FRAME_TIME.
+    sf::Clock frameClock;
+    bool showFrameStats = false;
+    // Статистика останнього ходу ШІ рівня 4 для панелі F3.
+    MonteCarloStats aiStats;
+    int frameStatsAge = 0;
+    sf::RectangleShape frameStatsBg;
+    sf::Text frameStatsText;
+
     void processEvents() {
         sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
+        while (window.pollEvent(event))
+            handleEvent(event);
+    }
 
-            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F11) {
-                fullscreen = !fullscreen;
-                recreateWindow(fullscreen);
-            }
+    void handleEvent(const sf::Event& event) {
+        dirty = true;
 
-            if (screen == MENU) {
-                if (event.type == sf::Event::KeyPressed) {
-                    if (event.key.code == sf::Keyboard::Up) {
-                        selected = (selected + menuItems.size() - 1) % menuItems.size();
-                    }
-                    if (event.key.code == sf::Keyboard::Down) {
-                        selected = (selected + 1) % menuItems.size();
-                    }
-                    if (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Space) {
+        if (event.type == sf::Event::Closed)
+            window.close();
+
+        if (event.type == sf::Event::Resized)
+            relayout();
+
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F11)
+            setFullscreen(!fullscreen);
+
+        sf::Vector2f click;
+        if (event.type == sf::Event::MouseButtonPressed)
+            click = toScene(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            showFrameStats = !showFrameStats;
+            frameStatsAge = 0;
+        }
+
+        if (screen == MENU) {
+            if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::Up) {
+                    selected = (selected + menuItems.size() - 1) % menuItems.size();
+                }
+                if (event.key.code == sf::Keyboard::Down) {
+                    selected = (selected + 1) % menuItems.size();
+                }
+                if (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Space) {
+                    if (selected == 0) { screen = PLACING_CHOICE; }
+                    else if (selected == 1) { screen = SETTINGS; }
+                    else if (selected == 2) { screen = EXIT; }
+                }
+            }
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                for (size_t i = 0; i < menuTexts.size(); ++i) {
+                    if (menuTexts[i].getGlobalBounds().contains(click)) {
+                        selected = static_cast<int>(i);
                         if (selected == 0) { screen = PLACING_CHOICE; }
                         else if (selected == 1) { screen = SETTINGS; }
                         else if (selected == 2) { screen = EXIT; }
                     }
                 }
-                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                    for (size_t i = 0; i < menuTexts.size(); ++i) {
-                        if (menuTexts[i].getGlobalBounds().contains(event.mouseButton.x, event.mouseButton.y)) {
-                            selected = static_cast<int>(i);
-                            if (selected == 0) { screen = PLACING_CHOICE; }
-                            else if (selected == 1) { screen = SETTINGS; }
-                            else if (selected == 2) { screen = EXIT; }
-                        }
+            }
+        }
+        else if (screen == SETTINGS) {
+            if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::Up) {
+                    settingsSelected = (settingsSelected + settingsOptions.size() - 1) % settingsOptions.size();
+                    updateSettingsText();
+                }
+                if (event.key.code == sf::Keyboard::Down) {
+                    settingsSelected = (settingsSelected + 1) % settingsOptions.size();
+                    updateSettingsText();
+                }
+                if (event.key.code == sf::Keyboard::Left) {
+                    changeSetting(-1);
+                    updateSettingsText();
+                }
+                if (event.key.code == sf::Keyboard::Right) {
+                    changeSetting(1);
+                    updateSettingsText();
+                }
+                if (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Escape) {
+                    if (settingsSelected == (int)settingsOptions.size() - 1 || event.key.code == sf::Keyboard::Escape) {
+                        screen = MENU;
                     }
                 }
             }
-            else if (screen == SETTINGS) {
-                if (event.type == sf::Event::KeyPressed) {
-                    if (event.key.code == sf::Keyboard::Up) {
-                        settingsSelected = (settingsSelected + settingsOptions.size() - 1) % settingsOptions.size();
-                        updateSettingsText();
-                    }
-                    if (event.key.code == sf::Keyboard::Down) {
-                        settingsSelected = (settingsSelected + 1) % settingsOptions.size();
-                        updateSettingsText();
-                    }
-                    if (event.key.code == sf::Keyboard::Left) {
-                        changeSetting(-1);
-                        updateSettingsText();
-                    }
-                    if (event.key.code == sf::Keyboard::Right) {
-                        changeSetting(1);
-                        updateSettingsText();
-                    }
-                    if (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Escape) {
-                        if (settingsSelected == (int)settingsOptions.size() - 1 || event.key.code == sf::Keyboard::Escape) {
-                            screen = MENU;
-                        }
-                    }
+        }
+        else if (screen == PLACING_CHOICE) {
+            if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::Num1 || event.key.code == sf::Keyboard::Numpad1) {
+                    startGame(true);
+                }
+                if (event.key.code == sf::Keyboard::Num2 || event.key.code == sf::Keyboard::Numpad2) {
+                    startGame(false);
+                }
+                if (event.key.code == sf::Keyboard::Escape) {
+                    screen = MENU;
                 }
             }
-            else if (screen == PLACING_CHOICE) {
-                if (event.type == sf::Event::KeyPressed) {
-                    if (event.key.code == sf::Keyboard::Num1 || event.key.code == sf::Keyboard::Numpad1) {
-                        resetGame();
-                        randomPlaceShips();
-                        screen = PLAYING;
-                    }
-                    if (event.key.code == sf::Keyboard::Num2 || event.key.code == sf::Keyboard::Numpad2) {
-                        resetGame();
-                        screen = PLACING;
-                    }
-                    if (event.key.code == sf::Keyboard::Escape) {
-                        screen = MENU;
-                    }
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                if (placeChoiceText2.getGlobalBounds().contains(click)) {
+                    startGame(true);
                 }
-                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                    if (placeChoiceText2.getGlobalBounds().contains(event.mouseButton.x, event.mouseButton.y)) {
-                        resetGame();
-                        randomPlaceShips();
-                        screen = PLAYING;
-                    }
-                    if (placeChoiceText3.getGlobalBounds().contains(event.mouseButton.x, event.mouseButton.y)) {
-                        resetGame();
-                        screen = PLACING;
-                    }
+                if (placeChoiceText3.getGlobalBounds().contains(click)) {
+                    startGame(false);
                 }
             }
-            else if (screen == PLACING) {
-                if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                    sf::Vector2i cell = getCellFromMouse(event.mouseButton.x, event.mouseButton.y, false);
-                    if (cell.x != -1 && currentShipIdx < (int)shipsToPlace.size()) {
-                        int size = shipsToPlace[currentShipIdx];
-                        if (playerBoard.canPlaceShip(cell.x, cell.y, size, placingVertical)) {
-                            playerBoard.placeShipManual(cell.x, cell.y, size, placingVertical);
-                            currentShipIdx++;
-                        }
-                    }
-                    if (randomText.getGlobalBounds().contains(event.mouseButton.x, event.mouseButton.y)) {
-                        randomPlaceShips();
-                    }
-                    if (playText.getGlobalBounds().contains(event.mouseButton.x, event.mouseButton.y) && currentShipIdx >= (int)shipsToPlace.size()) {
-                        screen = PLAYING;
+        }
+        else if (screen == PLACING) {
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                Coord cell = getCellAt(click, false);
+                if (cell.x != -1 && currentShipIdx < (int)shipsToPlace.size()) {
+                    int size = shipsToPlace[currentShipIdx];
+                    if (playerBoard.canPlaceShip(cell.x, cell.y, size, placingVertical)) {
+                        playerBoard.placeShipManual(cell.x, cell.y, size, placingVertical);
+                        currentShipIdx++;
                     }
                 }
-                if (event.type == sf::Event::KeyPressed) {
-                    if (event.key.code == sf::Keyboard::R) {
-                        placingVertical = !placingVertical;
-                    }
-                    if (event.key.code == sf::Keyboard::Escape) {
-                        screen = MENU;
-                    }
+                if (randomText.getGlobalBounds().contains(click)) {
+                    randomPlaceShips();
+                }
+                if (playText.getGlobalBounds().contains(click) && currentShipIdx >= (int)shipsToPlace.size()) {
+                    beginPlay();
                 }
             }
-            else if (screen == PLAYING) {
-                if (!gameOver && playerTurn &&
-                    event.type == sf::Event::MouseButtonPressed &&
-                    event.mouseButton.button == sf::Mouse::Left)
-                {
-                    handlePlayerClick(event.mouseButton.x, event.mouseButton.y);
+            if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::R) {
+                    placingVertical = !placingVertical;
                 }
-                if (gameOver && event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::Escape) {
                     screen = MENU;
                 }
             }
         }
+        else if (screen == PLAYING) {
+            if (!gameOver && playerTurn &&
+                event.type == sf::Event::MouseButtonPressed &&
+                event.mouseButton.button == sf::Mouse::Left)
+            {
+                handlePlayerClick(click);
+            }
+            if (gameOver && event.type == sf::Event::KeyPressed) {
+                screen = MENU;
+            }
+        }
     }
 
     void changeSetting(int dir) {
         if (settingsSelected == 0) {
             settings.aiLevel += dir;
-            if (settings.aiLevel < 1) settings.aiLevel = 2;
-            if (settings.aiLevel > 2) settings.aiLevel = 1;
+            if (settings.aiLevel < 1) settings.aiLevel = 4;
+            if (settings.aiLevel > 4) settings.aiLevel = 1;
         }
         if (settingsSelected == 1) {
             settings.gridSize += dir;
@@ -708,7 +636,7 @@ private:
             if (settings.gridSize > 15) settings.gridSize = 6;
         }
         if (settingsSelected == 2) {
-            static std::vector<std::vector<int>> presets = {
+            static const std::vector<ShipSet> presets = {
                 {5,4,3,3,2},
                 {4,3,3,2,2,2},
                 {3,3,2,2,2,1,1}
@@ -719,7 +647,32 @@ private:
             if (idx >= (int)presets.size()) idx = 0;
             settings.shipSet = presets[idx];
         }
-        recreateWindow(fullscreen);
+        if (settingsSelected == 3) {
+            static const int budgets[] = { 5, 50, 500 };
+            int idx = 0;
+            while (idx < 2 && budgets[idx] != settings.aiTimeBudgetMs) idx++;
+            idx = (idx + dir + 3) % 3;
+            settings.aiTimeBudgetMs = budgets[idx];
+        }
+        if (settingsSelected == 4) {
+            static const int delays[] = { 0, 150, 300, 600 };
+            int idx = 0;
+            while (idx < 3 && delays[idx] != settings.aiShotDelayMs) idx++;
+            idx = (idx + dir + 4) % 4;
+            settings.aiShotDelayMs = delays[idx];
+        }
+        // Дешева перевірка без таблиці: таблицю щільного флоту генератор побудує на першій
+        // розстановці партії, а не на кожне натискання.
+        if (settingsSelected == 1 || settingsSelected == 2)
+            fleetFits = FleetGenerator::check(settings.gridSize, settings.shipSet) == FleetStatus::Ok;
+        if (settingsSelected == 1) {
+            // Вікно лише підганяється під нове поле, без перестворення.
+            if (!fullscreen) {
+                sf::VideoMode mode = windowedMode(settings.gridSize);
+                window.setSize(sf::Vector2u(mode.width, mode.height));
+            }
+            relayout();
+        }
     }
 
     void updateSettingsText() {
@@ -728,7 +681,8 @@ private:
         for (size_t i = 0; i < settingsOptions.size(); ++i) {
             std::string line = settingsOptions[i];
             if (i == 0) {
-                line += (settings.aiLevel == 1 ? u8"Простий" : u8"Розумний");
+                static const char* levelNames[] = { u8"Простий", u8"Розумний", u8"Ймовірнісний", u8"Монте-Карло" };
+                line += levelNames[settings.aiLevel - 1];
             }
             if (i == 1) {
                 line += std::to_string(settings.gridSize) + "x" + std::to_string(settings.gridSize);
@@ -741,10 +695,18 @@ private:
                 }
                 line += "]";
             }
-            if (i == settingsSelected) line = "> " + line;
+            if (i == 3) {
+                line += std::to_string(settings.aiTimeBudgetMs) + u8" мс";
+            }
+            if (i == 4) {
+                line += std::to_string(settings.aiShotDelayMs) + u8" мс";
+            }
+            if ((int)i == settingsSelected) line = "> " + line;
             oss << line << "\n";
         }
-        oss << u8"\n←/→ — змінити, ↑/↓ — выбрати, Enter/Esc — назад\nF11 — повноекранний режим";
+        if (!fleetFits)
+            oss << u8"\n" << fleetWarning << "\n";
+        oss << u8"\n←/→ — змінити, ↑/↓ — выбрати, Enter/Esc — назад\nF11 — повноекранний режим, F3 — час кадру";
         std::string settingsStr = oss.str();
         settingsText.setFont(font);
         settingsText.setCharacterSize(24);
@@ -753,21 +715,24 @@ private:
         settingsText.setPosition(PADDING + 40, PADDING + 40);
     }
 
-    sf::Vector2i getCellFromMouse(int mouseX, int mouseY, bool aiBoardSide) {
-        int offsetX = aiBoardSide ? (PADDING * 2 + settings.gridSize * CELL_SIZE) : PADDING;
-        int offsetY = PADDING;
-        int boardX = mouseX - offsetX;
-        int boardY = mouseY - offsetY;
-        if (boardX < 0 || boardY < 0) return sf::Vector2i(-1, -1);
-        sf::Vector2i cell(boardX / CELL_SIZE, boardY / CELL_SIZE);
-        if (cell.x < 0 || cell.x >= settings.gridSize || cell.y < 0 || cell.y >= settings.gridSize) return sf::Vector2i(-1, -1);
+    // Клітинка поля під точкою сцени або (-1, -1).
+    Coord getCellAt(const sf::Vector2f& point, bool aiBoardSide) {
+        sf::Vector2f origin = aiBoardSide ? enemyOrigin() : playerOrigin();
+        float boardX = point.x - origin.x;
+        float boardY = point.y - origin.y;
+        if (boardX < 0 || boardY < 0) return Coord(-1, -1);
+        Coord cell(static_cast<int>(boardX) / cellSize, static_cast<int>(boardY) / cellSize);
+        if (cell.x < 0 || cell.x >= settings.gridSize || cell.y < 0 || cell.y >= settings.gridSize) return Coord(-1, -1);
         return cell;
     }
 
-    void handlePlayerClick(int x, int y) {
-        sf::Vector2i cell = getCellFromMouse(x, y, true);
+    void handlePlayerClick(const sf::Vector2f& point) {
+        Coord cell = getCellAt(point, true);
         if (cell.x == -1) return;
+        bool fresh = !aiBoard.isShotCell(cell.x, cell.y);
         bool hit = aiBoard.receiveShot(cell);
+        if (fresh)
+            recordShot(0, cell, hit, aiBoard);
         shots++;
         if (hit) {
             this->hits++;
@@ -781,159 +746,199 @@ private:
         addEffect(cell, hit);
 
         if (aiBoard.allSunk()) gameOver = true;
-        else if (!hit) { playerTurn = false; aiMove(); }
+        else if (!hit) {
+            playerTurn = false;
+            aiWorker.startTurn(playerBoard, settings.aiLevel);
+            aiRevealTimer = settings.aiShotDelayMs / 1000.f;
+        }
     }
 
-    void aiMove() {
-        sf::Vector2i cell = ai.getMove(playerBoard, settings.aiLevel);
-        bool hit = playerBoard.receiveShot(cell);
-        addEffectAI(cell, hit);
+    // Хід ШІ рахується у фоновому потоці; тут готові постріли забираються з черги
+    // і показуються по одному з паузою aiShotDelayMs між ними.
+    void updateAI(float dt) {
+        if (screen != PLAYING || playerTurn || gameOver)
+            return;
+        aiRevealTimer -= dt;
+        if (aiRevealTimer > 0.f)
+            return;
+        AIShot shot;
+        if (!aiWorker.poll(shot))
+            return;
+        if (settings.aiLevel == 4)
+            aiStats = shot.stats;
+        bool hit = playerBoard.receiveShot(shot.cell);
+        recordShot(1, shot.cell, hit, playerBoard);
+        addEffectAI(shot.cell, hit);
         if (hit) hitSound.play(); else missSound.play();
+        aiRevealTimer = settings.aiShotDelayMs / 1000.f;
 
         if (playerBoard.allSunk()) gameOver = true;
-        else if (!hit) playerTurn = true;
-        else aiMove();
+        else if (!hit || shot.last) playerTurn = true;
     }
 
-    void addEffect(sf::Vector2i cell, bool hit) {
-        Effect e;
-        float radius = CELL_SIZE / 2 - 2;
-        e.shape = sf::CircleShape(radius);
-        e.shape.setOrigin(radius, radius);
-        sf::Vector2f base(PADDING * 2 + settings.gridSize * CELL_SIZE, PADDING);
-        if (!hit) e.shape.setFillColor(sf::Color(180, 160, 120, 200));
-        else      e.shape.setFillColor(sf::Color(200, 60, 30, 200));
-        e.shape.setPosition(
-            base.x + cell.x * CELL_SIZE + CELL_SIZE / 2,
-            base.y + cell.y * CELL_SIZE + CELL_SIZE / 2
-        );
-        e.lifetime = 0.5f;
-        e.isWave = false;
-        effects.push_back(e);
+    // Запис партії починається, коли обидва флоти розставлені.
+    void beginPlay() {
+        screen = PLAYING;
+        replay.close();
+        if (replayDir.empty())
+            return;
+        ReplayHeader header;
+        header.gridSize = settings.gridSize;
+        header.aiLevel = settings.aiLevel;
+        header.seed = round.seed();
+        header.fleets[0] = ReplayWriter::fleetOf(playerBoard);
+        header.fleets[1] = ReplayWriter::fleetOf(aiBoard);
+        std::string path = ReplayWriter::archivePath(replayDir);
+        if (!replay.open(path, header))
+            std::cerr << "Не вдалося створити запис " << path << std::endl;
     }
 
-    void addEffectAI(sf::Vector2i cell, bool hit) {
-        Effect e;
-        float radius = CELL_SIZE / 2 - 2;
-        e.shape = sf::CircleShape(radius);
-        e.shape.setOrigin(radius, radius);
-        sf::Vector2f base(PADDING, PADDING);
-        if (!hit) e.shape.setFillColor(sf::Color(180, 160, 120, 200));
-        else      e.shape.setFillColor(sf::Color(200, 60, 30, 200));
-        e.shape.setPosition(
-            base.x + cell.x * CELL_SIZE + CELL_SIZE / 2,
-            base.y + cell.y * CELL_SIZE + CELL_SIZE / 2
-        );
-        e.lifetime = 0.5f;
-        e.isWave = false;
-        effects.push_back(e);
+    void recordShot(int shooter, Coord cell, bool hit, const Board& target) {
+        ReplayShot s;
+        s.cell = cell;
+        s.shooter = shooter;
+        s.hit = hit;
+        s.sunk = target.justSunkShip() >= 0;
+        s.gameOver = target.allSunk();
+        replay.shot(s);
     }
 
-    void updateEffects(float dt) {
-        for (auto it = effects.begin(); it != effects.end();) {
-            if (it->isWave) {
-                it->wavePhase += dt * 2.5f;
-                float scale = 1.0f + 0.2f * std::sin(it->wavePhase * 3.14f);
-                it->shape.setScale(scale, scale);
-                sf::Color col = it->shape.getFillColor();
-                col.a = static_cast<sf::Uint8>(180 * std::max(0.f, 1.0f - it->wavePhase / 2.0f));
-                it->shape.setFillColor(col);
-                it->lifetime -= dt;
-                if (it->lifetime <= 0.f) it = effects.erase(it);
-                else ++it;
-            }
-            else {
-                it->lifetime -= dt;
-                float ratio = it->lifetime / 0.5f;
-                it->shape.setScale(1.f + (1.f - ratio), 1.f + (1.f - ratio));
-                sf::Color col = it->shape.getFillColor();
-                col.a = static_cast<sf::Uint8>(255 * std::max(ratio, 0.f));
-                it->shape.setFillColor(col);
-                if (it->lifetime <= 0.f) it = effects.erase(it);
-                else ++it;
-            }
+    // Кадр треба малювати й без подій: йде анімація або ШІ ще робить хід.
+    bool animating() const {
+        return particles.size() > 0 || (screen == PLAYING && !playerTurn && !gameOver);
+    }
+
+    void addEffect(Coord cell, bool hit) {
+        spawnShotEffect(aiBoard, enemyOrigin(), cell, hit);
+    }
+
+    void addEffectAI(Coord cell, bool hit) {
+        spawnShotEffect(playerBoard, playerOrigin(), cell, hit);
+    }
+
+    sf::Vector2f cellCenter(const sf::Vector2f& base, int x, int y) const {
+        return sf::Vector2f(base.x + x * cellSize + cellSize / 2, base.y + y * cellSize + cellSize / 2);
+    }
+
+    void spawnShotEffect(const Board& board, const sf::Vector2f& base, Coord cell, bool hit) {
+        float radius = cellSize / 2 - 2;
+        sf::Color color = hit ? sf::Color(200, 60, 30, 200) : sf::Color(180, 160, 120, 200);
+        particles.spawn(Splash, cellCenter(base, cell.x, cell.y), sf::Vector2f(), radius, color, 0.5f);
+        if (!hit) return;
+
+        spawnExplosion(cellCenter(base, cell.x, cell.y), 10);
+        int sunk = board.justSunkShip();
+        if (sunk >= 0) {
+            sunkWaveTime = SUNK_WAVE_DURATION;
+            for (const auto& p : board.getShips()[sunk].positions)
+                spawnExplosion(cellCenter(base, p.x, p.y), 6);
+        }
+    }
+
+    void spawnExplosion(const sf::Vector2f& center, int pieces) {
+        std::uniform_real_distribution<float> angleDist(0.f, 2.f * 3.14159265f);
+        std::uniform_real_distribution<float> speedDist(cellSize * 1.5f, cellSize * 4.f);
+        for (int i = 0; i < pieces; ++i) {
+            float a = angleDist(rng), v = speedDist(rng);
+            sf::Color color = (i % 2) ? sf::Color(255, 200, 60) : sf::Color(230, 90, 30);
+            particles.spawn(Explosion, center, sf::Vector2f(std::cos(a) * v, std::sin(a) * v), cellSize / 8.f + 1.f, color, 0.6f);
+        }
+    }
+
+    // Хвиля над кожною клітинкою потопленого корабля; ключ не дає дублювати активну хвилю.
+    // Хвилі відновлюються лише SUNK_WAVE_DURATION після останнього потоплення.
+    void spawnSunkWaves() {
+        if (sunkWaveTime <= 0.f) return;
+        const Board* boards[2] = { &playerBoard, &aiBoard };
+        sf::Vector2f bases[2] = { playerOrigin(), enemyOrigin() };
+        float radius = cellSize / 2 - 2;
+        for (int b = 0; b < 2; ++b) {
+            boards[b]->sunkCells().forEach([&](int x, int y) {
+                int key = b * BIT_STRIDE * BIT_STRIDE + BitBoard::bitIndex(x, y);
+                if (!particles.hasKey(key))
+                    particles.spawn(Wave, cellCenter(bases[b], x, y), sf::Vector2f(), radius, sf::Color::White, 1.5f, key);
+            });
         }
     }
 
+    void updateEffects(float dt) {
+        particles.update(dt);
+        sunkWaveTime = std::max(0.f, sunkWaveTime - dt);
+    }
+
     void drawHighlight() {
         if (!playerTurn || gameOver) return;
-        sf::Vector2i mouse = sf::Mouse::getPosition(window);
-        sf::Vector2i cell = getCellFromMouse(mouse.x, mouse.y, true);
+        Coord cell = getCellAt(toScene(sf::Mouse::getPosition(window)), true);
         if (cell.x == -1) return;
-        sf::RectangleShape hl(sf::Vector2f(CELL_SIZE - 1, CELL_SIZE - 1));
-        hl.setPosition(
-            PADDING * 2 + settings.gridSize * CELL_SIZE + cell.x * CELL_SIZE,
-            PADDING + cell.y * CELL_SIZE
-        );
+        sf::RectangleShape hl(sf::Vector2f(cellSize - 1, cellSize - 1));
+        hl.setPosition(enemyOrigin() + sf::Vector2f(cell.x * cellSize, cell.y * cellSize));
         hl.setFillColor(sf::Color(220, 180, 60, 80));
         window.draw(hl);
     }
 
     void drawEffects() {
-        for (auto& e : effects)
-            window.draw(e.shape);
+        particles.draw(window);
+    }
+
+    static void setUtf8(sf::Text& text, const std::string& str) {
+        text.setString(sf::String::fromUtf8(str.begin(), str.end()));
     }
 
+    // Рядки статусу, статистики й підказок перебудовуються лише тоді, коли змінюється
+    // те, що вони показують; у звичайному кадрі текст тільки малюється.
     void drawStatus() {
-        std::string str;
-        if (gameOver)
-            str = u8"Гра закінчена! Натисніть будь-яку клавішу, щоб повернутися до меню.";
-        else if (playerTurn)
-            str = u8"Ваш хід: клацніть по ворожій сітці.";
-        else
-            str = u8"Хід противника...";
-        statusText.setString(sf::String::fromUtf8(str.begin(), str.end()));
+        int state = gameOver ? 3 : playerTurn ? 0 : aiWorker.thinking() ? 1 : 2;
+        if (state != statusShown) {
+            static const char* lines[] = {
+                u8"Ваш хід: клацніть по ворожій сітці.",
+                u8"Противник думає...",
+                u8"Хід противника...",
+                u8"Гра закінчена! Натисніть будь-яку клавішу, щоб повернутися до меню."
+            };
+            statusShown = state;
+            setUtf8(statusText, lines[state]);
+        }
         window.draw(statusText);
     }
 
     void drawStats() {
-        std::ostringstream oss;
-        oss << u8"Пострілів: " << shots
-            << u8"   Попадань: " << hits
-            << u8"   Промахів: " << misses
-            << u8"   Точність: ";
-        if (shots > 0)
-            oss << std::fixed << std::setprecision(1) << (100.0 * hits / shots) << "%";
-        else
-            oss << "-";
-        std::string statsStr = oss.str();
-        sf::Text stats(sf::String::fromUtf8(statsStr.begin(), statsStr.end()), font, 18);
-        stats.setFillColor(sf::Color(220, 200, 160));
-        stats.setPosition(PADDING, WINDOW_HEIGHT - BOTTOM_PANEL + 10);
-        window.draw(stats);
+        if (shots != statsShown[0] || hits != statsShown[1] || misses != statsShown[2]) {
+            statsShown = { shots, hits, misses };
+            std::ostringstream oss;
+            oss << u8"Пострілів: " << shots
+                << u8"   Попадань: " << hits
+                << u8"   Промахів: " << misses
+                << u8"   Точність: ";
+            if (shots > 0)
+                oss << std::fixed << std::setprecision(1) << (100.0 * hits / shots) << "%";
+            else
+                oss << "-";
+            setUtf8(statsText, oss.str());
+        }
+        window.draw(statsText);
     }
 
     void drawHint() {
-        if (consecMiss >= 5 && !gameOver && playerTurn) {
-            std::string hintStr = u8"Підказка: спробуйте стріляти \"шахівкою\" для пошуку кораблів!";
-            sf::Text hint(sf::String::fromUtf8(hintStr.begin(), hintStr.end()), font, 18);
-            hint.setFillColor(sf::Color(220, 180, 60));
-            hint.setStyle(sf::Text::Bold);
-            hint.setPosition(PADDING, WINDOW_HEIGHT - BOTTOM_PANEL + 40);
-            window.draw(hint);
-        }
+        if (consecMiss >= 5 && !gameOver && playerTurn)
+            window.draw(hintText);
     }
 
     void drawMenu() {
-        std::string titleStr = u8"Морський бій";
-        sf::Text title(sf::String::fromUtf8(titleStr.begin(), titleStr.end()), font, 40);
-        title.setFillColor(sf::Color(220, 180, 60));
-        title.setStyle(sf::Text::Bold);
-        title.setPosition(PADDING + 30, PADDING);
-        window.draw(title);
-
-        for (size_t i = 0; i < menuTexts.size(); ++i) {
-            if (static_cast<int>(i) == selected)
-                menuTexts[i].setFillColor(sf::Color(220, 180, 60));
-            else
-                menuTexts[i].setFillColor(sf::Color(220, 200, 160));
-            window.draw(menuTexts[i]);
+        window.draw(titleText);
+
+        if (selected != menuSelectedShown) {
+            menuSelectedShown = selected;
+            for (size_t i = 0; i < menuTexts.size(); ++i) {
+                if (static_cast<int>(i) == selected)
+                    menuTexts[i].setFillColor(sf::Color(220, 180, 60));
+                else
+                    menuTexts[i].setFillColor(sf::Color(220, 200, 160));
+            }
         }
-        std::string infoStr = u8"Навігація: стрілки ВВЕРХ/ВНИЗ, Enter — вибрати\nF11 — повноекранний режим";
-        sf::Text info(sf::String::fromUtf8(infoStr.begin(), infoStr.end()), font, 16);
-        info.setFillColor(sf::Color(120, 100, 80));
-        info.setPosition(PADDING + 30, WINDOW_HEIGHT - BOTTOM_PANEL + 10);
-        window.draw(info);
+        for (const auto& t : menuTexts)
+            window.draw(t);
+
+        window.draw(menuInfoText);
     }
 
     void drawSettings() {
@@ -944,81 +949,107 @@ private:
         window.draw(placeChoiceText1);
         window.draw(placeChoiceText2);
         window.draw(placeChoiceText3);
+        if (!fleetFits)
+            window.draw(warningText);
     }
 
     void drawPlacing() {
-        sf::Vector2i mouse = sf::Mouse::getPosition(window);
-        sf::Vector2i cell = getCellFromMouse(mouse.x, mouse.y, false);
+        Coord cell = getCellAt(toScene(sf::Mouse::getPosition(window)), false);
         int size = (currentShipIdx < (int)shipsToPlace.size()) ? shipsToPlace[currentShipIdx] : 0;
         bool valid = false;
         if (cell.x != -1 && currentShipIdx < (int)shipsToPlace.size())
             valid = playerBoard.canPlaceShip(cell.x, cell.y, size, placingVertical);
 
-        playerBoard.draw(window, sf::Vector2f(PADDING, PADDING), effects,
+        playerView.draw(window, playerBoard, playerOrigin(), cellSize,
             size, cell.x, cell.y, placingVertical, valid);
 
-        std::ostringstream oss;
-        if (currentShipIdx < (int)shipsToPlace.size()) {
-            oss << u8"Розставте корабель: " << shipsToPlace[currentShipIdx]
-                << u8"  (R – повернути, ESC – у меню)";
-        }
-        else {
-            oss << u8"Усі кораблі розставлені!";
+        if (currentShipIdx != placeShown) {
+            placeShown = currentShipIdx;
+            std::ostringstream oss;
+            if (currentShipIdx < (int)shipsToPlace.size()) {
+                oss << u8"Розставте корабель: " << shipsToPlace[currentShipIdx]
+                    << u8"  (R – повернути, ESC – у меню)";
+            }
+            else {
+                oss << u8"Усі кораблі розставлені!";
+            }
+            setUtf8(placeText, oss.str());
+            placeText.setPosition(PADDING + 10, PADDING - 40);
         }
-        std::string utf8String = oss.str();
-        placeText.setString(sf::String::fromUtf8(utf8String.begin(), utf8String.end()));
-        placeText.setPosition(PADDING + 10, PADDING - 40);
         window.draw(placeText);
 
-        randomText.setPosition(PADDING + 10, PADDING + settings.gridSize * CELL_SIZE + 20);
         window.draw(randomText);
-        if (currentShipIdx >= (int)shipsToPlace.size()) {
-            playText.setPosition(PADDING + 200, PADDING + settings.gridSize * CELL_SIZE + 20);
+        if (currentShipIdx >= (int)shipsToPlace.size())
             window.draw(playText);
+    }
+
+    // Панель часу кадру (F3): перцентилі за останні кадри і середнє/максимум кожної фази.
+    // Текст перебудовується раз на 15 кадрів, щоб сама панель не засмічувала заміри.
+    void drawFrameStats() {
+        static const char* phaseLabels[PHASE_COUNT] = {
+            u8"події", u8"оновлення", u8"поля", u8"інтерфейс", u8"мінікарта", u8"display"
+        };
+        if (frameStatsAge-- <= 0) {
+            frameStatsAge = 15;
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(2)
+                << u8"Кадр, мс: p50 " << profiler.framePercentile(0.5)
+                << "  p95 " << profiler.framePercentile(0.95)
+                << "  p99 " << profiler.framePercentile(0.99)
+                << u8"  макс " << profiler.framePercentile(1.0) << "\n";
+            for (int p = 0; p < PHASE_COUNT; ++p) {
+                FramePhase phase = static_cast<FramePhase>(p);
+                oss << phaseLabels[p] << ": " << profiler.phaseMean(phase)
+                    << " / " << profiler.phaseMax(phase) << "\n";
+            }
+            if (settings.aiLevel == 4 && aiStats.samples > 0)
+                oss << u8"Монте-Карло: " << aiStats.samples << u8" вибірок, "
+                    << static_cast<long long>(aiStats.samplesPerSecond()) << u8"/с, "
+                    << aiStats.threads << u8" потоків\n";
+            std::string str = oss.str();
+            frameStatsText.setFont(font);
+            frameStatsText.setCharacterSize(14);
+            frameStatsText.setFillColor(sf::Color(220, 200, 160));
+            frameStatsText.setString(sf::String::fromUtf8(str.begin(), str.end()));
         }
+        sf::FloatRect bounds = frameStatsText.getLocalBounds();
+        frameStatsText.setPosition(scene.x - bounds.width - 20, 10);
+        frameStatsBg.setSize(sf::Vector2f(bounds.width + 20, bounds.height + 20));
+        frameStatsBg.setPosition(scene.x - bounds.width - 30, 5);
+        frameStatsBg.setFillColor(sf::Color(20, 20, 20, 180));
+        window.draw(frameStatsBg);
+        window.draw(frameStatsText);
     }
 
     void drawMiniMap() {
         const float scale = 0.25f;
-        const int miniCell = static_cast<int>(CELL_SIZE * scale);
-        const int miniGrid = miniCell * settings.gridSize;
+        const int miniCell = static_cast<int>(cellSize * scale);
+        const int miniWidth = miniCell * MiniMap::widthCells(settings.gridSize);
+        const int miniHeight = miniCell * settings.gridSize;
         const int margin = 10;
-        sf::Vector2f pos(WINDOW_WIDTH - miniGrid * 2 - margin * 2, WINDOW_HEIGHT - miniGrid - margin - 10);
+        sf::Vector2f pos(scene.x - miniWidth - margin * 2, scene.y - miniHeight - margin - 10);
 
-        sf::RectangleShape bg(sf::Vector2f(miniGrid * 2 + margin, miniGrid + margin));
-        bg.setFillColor(sf::Color(20, 20, 20, 180));
-        bg.setPosition(pos.x - margin, pos.y - margin);
-        window.draw(bg);
+        miniMapBg.setSize(sf::Vector2f(miniWidth + margin, miniHeight + margin));
+        miniMapBg.setFillColor(sf::Color(20, 20, 20, 180));
+        miniMapBg.setPosition(pos.x - margin, pos.y - margin);
+        window.draw(miniMapBg);
 
-        drawMiniBoard(playerBoard, pos, miniCell);
-        drawMiniBoard(aiBoard, sf::Vector2f(pos.x + miniGrid + margin / 2, pos.y), miniCell);
-    }
-
-    void drawMiniBoard(const Board& board, const sf::Vector2f& offset, int cellSize) {
-        for (int r = 0; r < settings.gridSize; ++r) {
-            for (int c = 0; c < settings.gridSize; ++c) {
-                sf::RectangleShape cellShape(sf::Vector2f(cellSize - 1, cellSize - 1));
-                cellShape.setPosition(offset.x + c * cellSize, offset.y + r * cellSize);
-
-                if (board.isSunkCell(sf::Vector2i(c, r)))
-                    cellShape.setFillColor(sf::Color(30, 120, 200));
-                else if (board.isShotCell(c, r))
-                    cellShape.setFillColor(sf::Color(220, 180, 60));
-                else
-                    cellShape.setFillColor(sf::Color(60, 50, 40));
-
-                window.draw(cellShape);
-            }
-        }
+        miniMap.draw(window, playerBoard, aiBoard, pos, miniCell);
     }
 
     void resetGame() {
+        round = session.game(roundNumber++);
+        playerPlacement = round.stream(RngStream::Board, 0);
+        Rng aiPlacement = round.stream(RngStream::Board, 1);
         playerBoard = Board(true, settings);
-        aiBoard = Board(false, settings);
-        ai.reset();
+        aiBoard = Board(false, settings, aiPlacement);
+        aiWorker.reset(settings, round.stream(RngStream::AI));
+        replay.close();
+        aiRevealTimer = 0.f;
         playerTurn = true;
         gameOver = false;
-        effects.clear();
+        particles.clear();
+        sunkWaveTime = 0.f;
         shots = 0;
         hits = 0;
         misses = 0;
@@ -1026,20 +1057,49 @@ private:
 
         shipsToPlace = settings.shipSet;
         currentShipIdx = 0;
+        placeShown = -1;
         placingVertical = false;
         playerBoard.clearShips();
     }
 
+    void startGame(bool randomPlacement) {
+        if (!fleetFits) return;
+        resetGame();
+        if (randomPlacement) {
+            randomPlaceShips();
+            beginPlay();
+        }
+        else {
+            screen = PLACING;
+        }
+    }
+
     void randomPlaceShips() {
-        playerBoard.clearShips();
-        Board tmp(false, settings);
-        playerBoard.setShips(tmp.getShips(), tmp.grid);
+        playerBoard.placeAllShips(playerPlacement);
         currentShipIdx = (int)shipsToPlace.size();
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
     Game game;
+    for (int i = 1; i < argc; ++i) {
+        // --frame-trace файл.csv — покадровий журнал часу фаз.
+        if (!std::strcmp(argv[i], "--frame-trace") && i + 1 < argc) {
+            if (!game.openFrameTrace(argv[++i]))
+                std::cerr << "Не вдалося відкрити " << argv[i] << std::endl;
+        }
+        // --continuous — малювати кожен кадр навіть без змін.
+        if (!std::strcmp(argv[i], "--continuous"))
+            game.setRenderOnDemand(false);
+        // --replay-dir каталог — куди писати записи партій (типово replays), --no-replays — не писати.
+        if (!std::strcmp(argv[i], "--replay-dir") && i + 1 < argc)
+            game.setReplayDir(argv[++i]);
+        if (!std::strcmp(argv[i], "--no-replays"))
+            game.setReplayDir("");
+        // --seed число — відтворювана сесія: ті самі розстановки й ходи ШІ при тих самих діях гравця.
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+            game.setSeed(std::strtoull(argv[++i], nullptr, 10));
+    }
     game.run();
     return 0;
 }
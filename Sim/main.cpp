@@ -0,0 +1,414 @@
+#include "Core/BoardBatch.h"
+#include "Core/GridShape.h"
+#include "Core/Replay.h"
+#include "Core/Simulation.h"
+#include "Core/Tournament.h"
+#ifdef SEABATTLE_CHECK_ALLOC
+#include "Instrument/AllocCounter.h"
+#endif
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Рівні ШІ 1-4; інші значення AI::getMove мовчки грав би як сусідній рівень.
+const int MAX_AI_LEVEL = 4;
+
+// Ціле число без зайвих символів у межах [lo, hi].
+bool parseNumber(const std::string& text, long long lo, long long hi, long long& value) {
+    if (text.empty())
+        return false;
+    char* end = nullptr;
+    errno = 0;
+    long long v = std::strtoll(text.c_str(), &end, 10);
+    if (errno || *end || v < lo || v > hi)
+        return false;
+    value = v;
+    return true;
+}
+
+bool parseLevel(const std::string& text, int& level) {
+    long long v;
+    if (!parseNumber(text, 1, MAX_AI_LEVEL, v))
+        return false;
+    level = static_cast<int>(v);
+    return true;
+}
+
+bool parseLevels(const char* arg, std::vector<int>& levels) {
+    levels.clear();
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int level;
+        if (!parseLevel(item, level))
+            return false;
+        levels.push_back(level);
+    }
+    return !levels.empty();
+}
+
+int usage() {
+    std::cerr << "usage: seabattle_sim [--games N] [--level L] [--grid N] [--budget MS] [--seed S]\n"
+                 "       seabattle_sim --tournament L1,L2[,...] [--games N] [--grid N] [--budget MS]\n"
+                 "                     [--threads T] [--seed S] [--histogram]\n"
+                 "       seabattle_sim --verify-batch [--games N] [--grid N] [--seed S]\n"
+#ifdef SEABATTLE_CHECK_ALLOC
+                 "       seabattle_sim --check-alloc [--games N] [--grid N] [--seed S]\n"
+#endif
+                 "       seabattle_sim --replay FILE.sbr [--turn T]\n"
+                 "levels are 1-" << MAX_AI_LEVEL << ", N is a positive number of games" << std::endl;
+    return EXIT_FAILURE;
+}
+
+long long percentile(const std::vector<long long>& hist, long long total, double q) {
+    long long need = static_cast<long long>(q * (total - 1)) + 1, seen = 0;
+    for (size_t i = 0; i < hist.size(); ++i) {
+        seen += hist[i];
+        if (seen >= need) return static_cast<long long>(i);
+    }
+    return 0;
+}
+
+void printDistribution(const char* label, int level, const std::vector<long long>& hist, long long wins, bool full) {
+    std::cout << "  L" << level << " " << label;
+    if (wins == 0) {
+        std::cout << " -" << std::endl;
+        return;
+    }
+    long long sum = 0;
+    for (size_t i = 0; i < hist.size(); ++i)
+        sum += hist[i] * static_cast<long long>(i);
+    std::cout << " mean " << std::fixed << std::setprecision(2) << double(sum) / wins
+              << "  min " << percentile(hist, wins, 0.0)
+              << "  p10 " << percentile(hist, wins, 0.1)
+              << "  p50 " << percentile(hist, wins, 0.5)
+              << "  p90 " << percentile(hist, wins, 0.9)
+              << "  max " << percentile(hist, wins, 1.0) << std::endl;
+    if (full) {
+        for (size_t i = 0; i < hist.size(); ++i)
+            if (hist[i])
+                std::cout << "    " << i << " " << hist[i] << std::endl;
+    }
+}
+
+int runTournamentMode(const TournamentOptions& options, bool histogram) {
+    TournamentResult result = runTournament(options);
+    if (result.fleet != FleetStatus::Ok) {
+        std::cerr << "tournament: " << (result.fleet == FleetStatus::Infeasible ? "fleet does not fit on " : "fleet could not be placed on ")
+                  << options.settings.gridSize << "x" << options.settings.gridSize << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "tournament: grid " << options.settings.gridSize << "x" << options.settings.gridSize
+              << ", " << options.gamesPerPair << " games per pair" << std::endl;
+    for (const auto& m : result.matches) {
+        std::cout << "L" << m.levelA << " vs L" << m.levelB << ": " << m.games << " games, "
+                  << "win rate L" << m.levelA << " " << std::fixed << std::setprecision(2) << 100.0 * m.winsA / m.games << "%, "
+                  << "L" << m.levelB << " " << 100.0 * m.winsB / m.games << "%" << std::endl;
+        printDistribution("shots to win:", m.levelA, m.shotsToWinA, m.winsA, histogram);
+        printDistribution("shots to win:", m.levelB, m.shotsToWinB, m.winsB, histogram);
+    }
+    std::cout << "total: " << result.games << " games in " << std::setprecision(3) << result.seconds << " s, "
+              << std::setprecision(0) << result.gamesPerSecond() << " games/s" << std::endl;
+    return 0;
+}
+
+// Проганяє ті самі потоки пострілів через Board і через BoardBatch на кожному рушії,
+// доступному в збірці, і звіряє результат пострілу та всі площини після кожного кроку.
+// Частина пострілів повторна або поза полем — такі не мають нічого змінювати.
+int runVerifyBatch(const Settings& settings, long long games, std::uint64_t seed) {
+    typedef std::chrono::steady_clock Clock;
+    const int n = settings.gridSize;
+    const int limit = n * n * 4;
+    std::unique_ptr<BoardBatch> batch(new BoardBatch());
+    std::vector<Board> boards;
+    std::vector<Coord> shots(BoardBatch::CAPACITY);
+    bool boardHit[BoardBatch::CAPACITY], batchHit[BoardBatch::CAPACITY], done[BoardBatch::CAPACITY];
+    long long mismatches = 0;
+
+    for (int e = 0; e <= static_cast<int>(BoardBatch::bestEngine()); ++e) {
+        BatchEngine engine = static_cast<BatchEngine>(e);
+        Rng rng = RngService(seed).stream(RngStream::Board);
+        long long shotsFired = 0, engineMismatches = 0;
+        double boardSeconds = 0, batchSeconds = 0;
+
+        for (long long first = 0; first < games; first += BoardBatch::CAPACITY) {
+            int lanes = static_cast<int>(std::min<long long>(BoardBatch::CAPACITY, games - first));
+            batch->clear();
+            batch->setEngine(engine);
+            boards.assign(lanes, Board(true, settings));
+            for (int i = 0; i < lanes; ++i) {
+                if (!boards[i].placeAllShips(rng) || !batch->add(boards[i])) {
+                    std::cerr << "verify: fleet does not fit on " << n << "x" << n << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+
+            for (int step = 0; step < limit; ++step) {
+                for (int i = 0; i < lanes; ++i)
+                    shots[i] = Coord(static_cast<int>(rng.below(n + 2)) - 1, static_cast<int>(rng.below(n + 2)) - 1);
+
+                auto start = Clock::now();
+                int boardsDone = 0;
+                for (int i = 0; i < lanes; ++i) {
+                    boardHit[i] = boards[i].receiveShot(shots[i]);
+                    boardsDone += boards[i].allSunk();
+                }
+                auto mid = Clock::now();
+                batch->receiveShots(shots.data(), batchHit);
+                int batchDone = batch->allSunk(done);
+                auto end = Clock::now();
+                boardSeconds += std::chrono::duration<double>(mid - start).count();
+                batchSeconds += std::chrono::duration<double>(end - mid).count();
+                shotsFired += lanes;
+
+                for (int i = 0; i < lanes; ++i) {
+                    const Board& b = boards[i];
+                    if (boardHit[i] != batchHit[i] || b.allSunk() != done[i] ||
+                        b.missCells() != batch->missCells(i) || b.hitCells() != batch->hitCells(i) ||
+                        b.sunkCells() != batch->sunkCells(i)) {
+                        if (engineMismatches == 0)
+                            std::cerr << "mismatch: engine " << BoardBatch::engineName(engine) << ", game " << first + i
+                                      << ", step " << step << ", shot (" << shots[i].x << "," << shots[i].y << ")" << std::endl;
+                        ++engineMismatches;
+                    }
+                }
+                if (boardsDone == lanes && batchDone == lanes)
+                    break;
+            }
+        }
+
+        std::cout << "verify " << std::left << std::setw(7) << BoardBatch::engineName(engine) << std::right
+                  << games << " games, " << shotsFired << " shots, " << engineMismatches << " mismatches; "
+                  << std::fixed << std::setprecision(1)
+                  << "Board " << shotsFired / boardSeconds / 1e6 << " Mshots/s, "
+                  << "batch " << shotsFired / batchSeconds / 1e6 << " Mshots/s" << std::endl;
+        mismatches += engineMismatches;
+    }
+    return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#ifdef SEABATTLE_CHECK_ALLOC
+// Партія так, як її веде гра: нові поля через присвоєння, розстановка флоту гравця,
+// скидання ШІ під налаштування і постріли по черзі до потоплення одного з флотів.
+// Суперник гравця — ШІ рівня 1. Повертає кількість пострілів або -1, якщо флот не розставлено.
+int playLifecycle(const Settings& settings, Board& player, Board& enemy, AI& ai, AI& opponent, const RngService& game) {
+    Rng placement[2] = { game.stream(RngStream::Board, 0), game.stream(RngStream::Board, 1) };
+    player = Board(true, settings);
+    enemy = Board(true, settings);
+    if (!enemy.placeAllShips(placement[1]) || !player.placeAllShips(placement[0]))
+        return -1;
+    ai.reset(settings);
+    opponent.reset(settings);
+    ai.setRng(game.stream(RngStream::AI, 0));
+    opponent.setRng(game.stream(RngStream::AI, 1));
+    int shots = 0;
+    int limit = settings.gridSize * settings.gridSize * 2;
+    while (!player.allSunk() && !enemy.allSunk() && shots < limit) {
+        enemy.receiveShot(opponent.getMove(enemy, 1));
+        player.receiveShot(ai.getMove(player, settings.aiLevel));
+        shots += 2;
+    }
+    return shots;
+}
+
+// Після розігріву повний цикл партії на рівнях 1-3 не має звертатися до купи.
+// Розігрів триває, доки WARMUP_GAMES партій поспіль не обійдуться без купи: таблиці
+// розміщень, генератор флоту й випадкові генератори потоку створюються при першому зверненні. Рівень 4 запускає потоки на кожен хід і не перевіряється.
+int runCheckAlloc(Settings settings, long long games, std::uint64_t seed) {
+    const int WARMUP_GAMES = 16, WARMUP_LIMIT = 1000;
+    RngService root(seed);
+    long long number = 0;
+    Board player(true, settings), enemy(true, settings);
+    AI ai(settings), opponent(settings);
+    long long failures = 0;
+    for (int level = 1; level <= 3; ++level) {
+        settings.aiLevel = level;
+        for (int quiet = 0, g = 0; quiet < WARMUP_GAMES && g < WARMUP_LIMIT; ++g) {
+            long long before = allocationCount();
+            if (playLifecycle(settings, player, enemy, ai, opponent, root.game(number++)) < 0)
+                return EXIT_FAILURE;
+            quiet = allocationCount() == before ? quiet + 1 : 0;
+        }
+        long long before = allocationCount(), shots = 0;
+        for (long long g = 0; g < games; ++g) {
+            int played = playLifecycle(settings, player, enemy, ai, opponent, root.game(number++));
+            if (played < 0)
+                return EXIT_FAILURE;
+            shots += played;
+        }
+        long long allocs = allocationCount() - before;
+        std::cout << "check-alloc L" << level << ": grid " << settings.gridSize << "x" << settings.gridSize
+                  << ", " << games << " games, " << shots << " shots, " << allocs << " allocations" << std::endl;
+        failures += allocs;
+    }
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
+
+// Чи вміщується флот налаштувань на полі; якщо ні — пояснення в stderr.
+bool checkFleet(const Settings& settings) {
+    FleetStatus status = FleetGenerator::shared(settings.gridSize, settings.shipSet).status();
+    if (status == FleetStatus::Ok)
+        return true;
+    std::cerr << (status == FleetStatus::Infeasible ? "fleet does not fit on " : "could not decide whether the fleet fits on ")
+              << settings.gridSize << "x" << settings.gridSize << std::endl;
+    return false;
+}
+
+// Обидва поля запису після turn пострілів (turn < 0 — кінець партії).
+int runReplayView(const std::string& path, int turn) {
+    ReplayReader reader;
+    if (!reader.open(path)) {
+        std::cerr << path << ": " << reader.error() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!reader.error().empty())
+        std::cerr << path << ": " << reader.error() << std::endl;
+    const ReplayHeader& h = reader.header();
+    if (turn < 0 || turn > reader.turns())
+        turn = reader.turns();
+
+    std::cout << path << ": grid " << h.gridSize << "x" << h.gridSize << ", AI level " << h.aiLevel
+              << ", seed " << h.seed << ", " << reader.turns() << " shots" << std::endl;
+    std::cout << "turn " << turn << "/" << reader.turns();
+    if (turn > 0) {
+        ReplayShot last = reader.shot(turn - 1);
+        std::cout << ", last: " << (last.shooter ? "AI" : "player") << " -> "
+                  << static_cast<char>('A' + last.cell.x) << last.cell.y + 1
+                  << (last.sunk ? " sunk" : last.hit ? " hit" : " miss") << (last.gameOver ? ", game over" : "");
+    }
+    std::cout << "\n\n";
+
+    // o — корабель, x — влучання, # — потоплений, * — промах.
+    ReplayPosition pos = reader.positionAt(turn);
+    const char* titles[2] = { "player fleet", "AI fleet" };
+    int width = h.gridSize * 2 + 3;
+    for (int f = 0; f < 2; ++f)
+        std::cout << std::left << std::setw(width + 2) << titles[f];
+    std::cout << std::right << "\n";
+    for (int f = 0; f < 2; ++f) {
+        std::cout << "   ";
+        for (int x = 0; x < h.gridSize; ++x)
+            std::cout << static_cast<char>('A' + x) << ' ';
+        std::cout << "  ";
+    }
+    std::cout << "\n";
+    for (int y = 0; y < h.gridSize; ++y) {
+        for (int f = 0; f < 2; ++f) {
+            std::cout << std::setw(2) << y + 1 << ' ';
+            for (int x = 0; x < h.gridSize; ++x) {
+                char c = '.';
+                if (pos.sunk[f].test(x, y)) c = '#';
+                else if (pos.hit[f].test(x, y)) c = 'x';
+                else if (pos.miss[f].test(x, y)) c = '*';
+                else if (reader.shipCells(f).test(x, y)) c = 'o';
+                std::cout << c << ' ';
+            }
+            std::cout << "  ";
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::flush;
+    return EXIT_SUCCESS;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Settings settings;
+    long long games = 10000;
+    bool tournament = false, histogram = false, verifyBatch = false;
+#ifdef SEABATTLE_CHECK_ALLOC
+    bool checkAlloc = false;
+#endif
+    std::string replayPath;
+    int replayTurn = -1;
+    TournamentOptions options;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--histogram")) histogram = true;
+        else if (!std::strcmp(argv[i], "--verify-batch")) verifyBatch = true;
+#ifdef SEABATTLE_CHECK_ALLOC
+        else if (!std::strcmp(argv[i], "--check-alloc")) checkAlloc = true;
+#endif
+        else if (hasValue && !std::strcmp(argv[i], "--replay")) replayPath = argv[++i];
+        else if (hasValue && !std::strcmp(argv[i], "--turn")) replayTurn = std::atoi(argv[++i]);
+        else if (hasValue && !std::strcmp(argv[i], "--games")) {
+            if (!parseNumber(argv[++i], 1, LLONG_MAX, games)) return usage();
+        }
+        else if (hasValue && !std::strcmp(argv[i], "--level")) {
+            if (!parseLevel(argv[++i], settings.aiLevel)) return usage();
+        }
+        else if (hasValue && !std::strcmp(argv[i], "--grid")) settings.gridSize = std::atoi(argv[++i]);
+        else if (hasValue && !std::strcmp(argv[i], "--budget")) settings.aiTimeBudgetMs = std::atoi(argv[++i]);
+        else if (hasValue && !std::strcmp(argv[i], "--tournament")) {
+            tournament = true;
+            if (!parseLevels(argv[++i], options.levels)) return usage();
+        }
+        else if (hasValue && !std::strcmp(argv[i], "--threads")) options.threads = std::atoi(argv[++i]);
+        else if (hasValue && !std::strcmp(argv[i], "--seed")) options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else
+            return usage();
+    }
+
+    if (!replayPath.empty())
+        return runReplayView(replayPath, replayTurn);
+
+    if (settings.gridSize < MIN_GRID_SIZE || settings.gridSize > MAX_GRID_SIZE) {
+        std::cerr << "grid must be within " << MIN_GRID_SIZE << "-" << MAX_GRID_SIZE << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!checkFleet(settings))
+        return EXIT_FAILURE;
+
+    if (verifyBatch)
+        return runVerifyBatch(settings, games, options.seed);
+
+#ifdef SEABATTLE_CHECK_ALLOC
+    if (checkAlloc)
+        return runCheckAlloc(settings, games, options.seed);
+#endif
+
+    if (tournament) {
+        options.settings = settings;
+        options.gamesPerPair = games;
+        return runTournamentMode(options, histogram);
+    }
+
+    AI ai(settings);
+    RngService root(options.seed);
+    long long totalShots = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long long g = 0; g < games; ++g) {
+        int shots = playOut(settings, ai, settings.aiLevel, root.game(g));
+        if (shots < 0) {
+            std::cerr << "game " << g << ": fleet could not be placed" << std::endl;
+            return EXIT_FAILURE;
+        }
+        totalShots += shots;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "games: " << games
+              << "  level: " << settings.aiLevel
+              << "  grid: " << settings.gridSize << "x" << settings.gridSize << "\n"
+              << "avg shots to win: " << (games ? double(totalShots) / games : 0.0) << "\n"
+              << "games/min: " << (secs > 0 ? games / secs * 60.0 : 0.0) << std::endl;
+    if (settings.aiLevel == 4) {
+        const MonteCarloStats& mc = ai.monteCarlo().totalStats();
+        std::cout << "monte carlo: " << mc.samplesPerSecond() << " samples/s on " << mc.threads
+                  << " threads (" << mc.accepted << " of " << mc.samples << " accepted)" << std::endl;
+    }
+    return 0;
+}